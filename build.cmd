@@ -4,7 +4,15 @@ call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliar
 
 cl /MD /LD /O2 /EHsc /DWIN32 /D_WINDOWS /DNDEBUG /DRENDERPLUGS_EXPORTS ^
 	src\gigascreen_main.cpp ^
+	src\capture_manager.cpp ^
 	src\lut_manager.cpp ^
     src\config_manager.cpp ^
+    src\input_manager.cpp ^
     src\notifications_manager.cpp ^
+    src\pipeline_manager.cpp ^
+    src\roi_manager.cpp ^
+    src\blend_engine.cpp ^
+    src\cache_manager.cpp ^
+    src\motion_manager.cpp ^
+    src\stats_manager.cpp ^
 	/link /OUT:gigascreen.rpi user32.lib
@@ -0,0 +1,22 @@
+@rem echo off
+
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars32.bat"
+
+cl /O2 /EHsc /std:c++17 /DNDEBUG ^
+	tools\gigascreen_convert.cpp ^
+	src\lut_manager.cpp ^
+	/Fe:gigascreen_convert.exe
+
+cl /O2 /EHsc /std:c++17 /DNDEBUG ^
+	tools\gigascreen_eval.cpp ^
+	src\lut_manager.cpp ^
+	/Fe:gigascreen_eval.exe
+
+cl /O2 /EHsc /std:c++17 /DNDEBUG ^
+	tools\gigascreen_lutgen.cpp ^
+	src\lut_manager.cpp ^
+	/Fe:gigascreen_lutgen.exe
+
+cl /O2 /EHsc /std:c++17 /DNDEBUG ^
+	tools\gigascreen_stats.cpp ^
+	/Fe:gigascreen_stats.exe
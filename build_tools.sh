@@ -0,0 +1,41 @@
+#!/bin/sh
+# Offline tools (Linux). The render plugin itself is Win32-only, see build.cmd;
+# gigascreen_bench builds its sources on Linux for profiling only.
+set -e
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-O2 -std=c++17 -DNDEBUG"}
+
+$CXX $CXXFLAGS -o gigascreen_convert \
+	tools/gigascreen_convert.cpp \
+	src/lut_manager.cpp \
+	-pthread
+
+$CXX $CXXFLAGS -o gigascreen_eval \
+	tools/gigascreen_eval.cpp \
+	src/lut_manager.cpp
+
+$CXX $CXXFLAGS -o gigascreen_lutgen \
+	tools/gigascreen_lutgen.cpp \
+	src/lut_manager.cpp
+
+$CXX $CXXFLAGS -o gigascreen_stats \
+	tools/gigascreen_stats.cpp \
+	-lrt
+
+# Benchmark/replay harness: the plugin sources with stage profiling enabled
+$CXX $CXXFLAGS -DGIGASCREEN_PROFILE -o gigascreen_bench \
+	tools/gigascreen_bench.cpp \
+	src/gigascreen_main.cpp \
+	src/capture_manager.cpp \
+	src/config_manager.cpp \
+	src/input_manager.cpp \
+	src/lut_manager.cpp \
+	src/notifications_manager.cpp \
+	src/pipeline_manager.cpp \
+	src/roi_manager.cpp \
+	src/blend_engine.cpp \
+	src/cache_manager.cpp \
+	src/motion_manager.cpp \
+	src/stats_manager.cpp \
+	-pthread -lrt
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// Blending core shared by the render plugin and the offline tools
+//
+// Portable (no WinAPI): operates on RGB565 pixels using a shared LUT set
+// from lut_manager.cpp.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "lut_manager.h"
+
+typedef struct {
+    const lut_set_t *lut; // gamma/ratio tables (lutmgr_get)
+    float ratio;          // weight of the most recent frame
+    int fullbright;       // additive 3Color blending
+} blend_params_t;
+
+// Gigascreen blending via LUTs
+static inline unsigned gigascreen_blend(const blend_params_t &bp, unsigned p0, unsigned p1) {
+    // Extract RGB pixel components for current frame (5-6-5 packed format)
+    unsigned frame0_r = (p0 >> 11) & 0x1F;
+    unsigned frame0_g = (p0 >> 5) & 0x3F;
+    unsigned frame0_b = p0 & 0x1F;
+
+    // Extract RGB pixel components for previous frame (5-6-5 packed format)
+    unsigned frame1_r = (p1 >> 11) & 0x1F;
+    unsigned frame1_g = (p1 >> 5) & 0x3F;
+    unsigned frame1_b = p1 & 0x1F;
+
+    // Look up precomputed blended components in encoded (5/6-bit) space
+    unsigned r = bp.lut->blend_5b[frame1_r][frame0_r] << 11;
+    unsigned g = bp.lut->blend_6b[frame1_g][frame0_g] << 5;
+    unsigned b = bp.lut->blend_5b[frame1_b][frame0_b];
+
+    return r | g | b;
+}
+
+// 3Color blending in linear light using LUTs
+static inline unsigned tricolor_blend(const blend_params_t &bp, unsigned p0, unsigned p1, unsigned p2) {
+    //  Fullbright blending
+    if (bp.fullbright) {
+        return p0 | p1 | p2; // simple mix, no gamma correction, no ratio
+    }
+
+    const lut_set_t *lut = bp.lut;
+
+    // Decode RGB components from 5-6-5 encoded space to linear colorspace (sRGB -> linear)
+    unsigned frame0_r = lut->rev_5b[(p0 >> 11) & 0x1F];
+    unsigned frame0_g = lut->rev_6b[(p0 >> 5) & 0x3F];
+    unsigned frame0_b = lut->rev_5b[p0 & 0x1F];
+
+    unsigned frame1_r = lut->rev_5b[(p1 >> 11) & 0x1F];
+    unsigned frame1_g = lut->rev_6b[(p1 >> 5) & 0x3F];
+    unsigned frame1_b = lut->rev_5b[p1 & 0x1F];
+
+    unsigned frame2_r = lut->rev_5b[(p2 >> 11) & 0x1F];
+    unsigned frame2_g = lut->rev_6b[(p2 >> 5) & 0x3F];
+    unsigned frame2_b = lut->rev_5b[p2 & 0x1F];
+
+    // Encode averaged linear components back to 5-6-5 encoded space (linear -> sRGB)
+    const float ratio_3c = (1.0 - bp.ratio) * 2.0;
+    const float ratio_rev = 1.0 - ratio_3c;
+    unsigned r =
+        lut->fwd_5b[int((frame0_r + frame1_r + frame2_r) / 3 * ratio_3c + frame0_r * ratio_rev)] << 11;
+    unsigned g =
+        lut->fwd_6b[int((frame0_g + frame1_g + frame2_g) / 3 * ratio_3c + frame0_g * ratio_rev)] << 5;
+    unsigned b =
+        lut->fwd_5b[int((frame0_b + frame1_b + frame2_b) / 3 * ratio_3c + frame0_b * ratio_rev)];
+
+    return r | g | b;
+}
+
+// 4-phase blending in linear light using LUTs (same weighting as 3Color)
+static inline unsigned quadcolor_blend(const blend_params_t &bp, unsigned p0, unsigned p1, unsigned p2,
+                                       unsigned p3) {
+    if (bp.fullbright) {
+        return p0 | p1 | p2 | p3;
+    }
+
+    const lut_set_t *lut = bp.lut;
+    unsigned sum_r = 0, sum_g = 0, sum_b = 0;
+    const unsigned px[4] = {p0, p1, p2, p3};
+    for (int i = 0; i < 4; i++) {
+        sum_r += lut->rev_5b[(px[i] >> 11) & 0x1F];
+        sum_g += lut->rev_6b[(px[i] >> 5) & 0x3F];
+        sum_b += lut->rev_5b[px[i] & 0x1F];
+    }
+
+    const float ratio_4c = (1.0 - bp.ratio) * 2.0;
+    const float ratio_rev = 1.0 - ratio_4c;
+    unsigned r = lut->fwd_5b[int(sum_r / 4 * ratio_4c + lut->rev_5b[(p0 >> 11) & 0x1F] * ratio_rev)] << 11;
+    unsigned g = lut->fwd_6b[int(sum_g / 4 * ratio_4c + lut->rev_6b[(p0 >> 5) & 0x3F] * ratio_rev)] << 5;
+    unsigned b = lut->fwd_5b[int(sum_b / 4 * ratio_4c + lut->rev_5b[p0 & 0x1F] * ratio_rev)];
+
+    return r | g | b;
+}
+
+// Check if RGB565 pixel has more than one color component
+static inline bool rgb565_has_multi_component(unsigned int c) {
+
+    // Components
+    unsigned r = c & 0b1111100000000000; // Red
+    unsigned g = c & 0b0000011111100000; // Green
+    unsigned b = c & 0b0000000000011111; // Blue
+
+    // More than one non-zero component?
+    return ((r != 0) + (g != 0) + (b != 0)) > 1;
+}
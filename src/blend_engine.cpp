@@ -0,0 +1,693 @@
+//------------------------------------------------------------------------------
+// Blending engine for Gigascreen Render Plugin
+//
+// Owns everything one frame stream needs: settings, the frame history ring,
+// per-pixel periodicity signatures, region-of-interest spans, CRT tables and
+// the notification overlay. LUT sets come from lutmgr_get() and are shared
+// read-only. The RPI entry points (gigascreen_main.cpp) drive one default
+// engine; tools can run one engine per stream and thread.
+//------------------------------------------------------------------------------
+
+#include "blend_engine.h"
+#include "blend_core.h"
+#include "cache_manager.h"
+#include "config_manager.h"
+#include "lut_manager.h"
+#include "motion_manager.h"
+#include "platform.h"
+#include "roi_manager.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Keep last N-frames for 3Color mode evaluation
+#define FRAME_HISTORY 5
+
+// Per-pixel periodicity signature (one byte):
+// bits 0-1 = detected period - 1 (periods 1..4),
+// bits 2-7 = consecutive frames matching the sample one period ago
+#define PERIOD_MAX 4
+#define PERIOD_RUN_ONE 4
+#define PERIOD_RUN_MAX 63
+#define PERIOD_OF(state) (((state) & 3) + 1)
+#define RUN_OF(state) ((state) >> 2)
+static_assert(FRAME_HISTORY > PERIOD_MAX, "period search reads the sample one period before frame N-1");
+
+// Phosphor mode: decay in 1/256 steps, capped so the accumulator keeps following the input
+#define PHOSPHOR_MODE 3
+#define PHOSPHOR_ONE 256
+#define PHOSPHOR_DECAY_MAX 0.95f
+
+// RGB565 colour per class (README: "Debug view")
+static const WORD s_class_colors[CLASS_COUNT] = {
+    0x0000, // pass: black
+    0x2945, // static: dark grey
+    0x07E0, // Gigascreen: green
+    0x07FF, // scroll: cyan
+    0xF81F, // 3Color: magenta
+    0xFFE0, // 4-phase: yellow
+    0xF800, // motion: red
+    0xFC00, // phosphor: orange
+};
+
+// Bytes a row touches per source pixel: source, history planes, signature,
+// 2x destination
+#define ROW_BYTES_PER_PIXEL (2 + FRAME_HISTORY * 2 + 1 + 8)
+
+struct engine_t {
+    engine_settings_t settings;
+    blend_params_t blend_params;
+    crt_lut_t crt;
+    bool crt_enabled;
+    phosphor_lut_t phosphor; // built by the first phosphor frame
+    bool phosphor_lut_ready;
+    unsigned phosphor_k; // decay, PHOSPHOR_ONE = 1.0
+
+    std::vector<WORD> frame_history;         // ring buffer for frame history
+    std::vector<unsigned char> period_state; // periodicity signature per pixel
+    std::vector<unsigned short> phosphor_acc; // linear RGB per pixel (mode 3 only)
+    bool phosphor_valid;
+    unsigned frame_size;
+    unsigned last_frame_idx;
+    unsigned w;
+    unsigned h;
+    unsigned strip_rows;
+    bool have_prev;
+    int debug_view;
+    bool class_stats;
+    unsigned class_pixels[CLASS_COUNT]; // last rendered frame
+
+    roi_t roi;
+    bool roi_valid; // the roi setting parsed without errors
+    notification_t overlay;
+};
+
+// - Settings / lifetime -------------------------------------------------------
+
+void engine_default_settings(engine_settings_t *settings) {
+    memset(settings, 0, sizeof(*settings));
+    settings->gamma = DEFAULT_GAMMA;
+    settings->ratio = DEFAULT_RATIO;
+    settings->mode = DEFAULT_MODE;
+    settings->fullbright = DEFAULT_FULLBRIGHT;
+    settings->motion_check = DEFAULT_MOTION_DETECTION;
+    settings->period_confidence = DEFAULT_PERIOD_CONFIDENCE;
+    settings->show_banner = DEFAULT_SHOW_BANNER;
+    settings->scanlines = DEFAULT_SCANLINES;
+    settings->mask = DEFAULT_MASK;
+    settings->mask_level = DEFAULT_MASK_LEVEL;
+    settings->phosphor_decay = DEFAULT_PHOSPHOR_DECAY;
+    settings->strip_rows = DEFAULT_STRIP_ROWS;
+    strcpy(settings->roi, "all");
+}
+
+void engine_load_settings(engine_settings_t *settings) {
+    engine_default_settings(settings);
+    settings->gamma = cfg_get_float("gamma", settings->gamma);
+    settings->ratio = cfg_get_float("ratio", settings->ratio);
+    settings->mode = cfg_get_int("mode", settings->mode);
+    settings->fullbright = cfg_get_int("fullbright", settings->fullbright);
+    settings->motion_check = cfg_get_int("motion_check", settings->motion_check);
+    settings->period_confidence = cfg_get_int("period_confidence", settings->period_confidence);
+    settings->show_banner = cfg_get_int("show_banner", settings->show_banner);
+    settings->scanlines = cfg_get_float("scanlines", settings->scanlines);
+    settings->mask = cfg_get_int("mask", settings->mask);
+    settings->mask_level = cfg_get_float("mask_level", settings->mask_level);
+    settings->phosphor_decay = cfg_get_float("phosphor_decay", settings->phosphor_decay);
+    settings->strip_rows = cfg_get_int("strip_rows", settings->strip_rows);
+    const char *roi = cfg_get_str("roi", NULL);
+    if (roi)
+        strncpy(settings->roi, roi, sizeof(settings->roi) - 1);
+}
+
+engine_t *engine_create(const engine_settings_t *settings) {
+    engine_t *e = new (std::nothrow) engine_t();
+    if (!e)
+        return NULL;
+
+    e->settings = *settings;
+    e->settings.roi[sizeof(e->settings.roi) - 1] = 0;
+    if (e->settings.period_confidence < 1)
+        e->settings.period_confidence = 1;
+    if (e->settings.period_confidence > PERIOD_RUN_MAX / PERIOD_MAX)
+        e->settings.period_confidence = PERIOD_RUN_MAX / PERIOD_MAX;
+
+    // Gamma lookup tables (LUTs) according to configuration, shared by all engines
+    e->blend_params.lut = lutmgr_get(e->settings.gamma, e->settings.ratio);
+    e->blend_params.ratio = e->settings.ratio;
+    e->blend_params.fullbright = e->settings.fullbright;
+
+    // Optional CRT post-process, folded into the 2x output write
+    e->crt_enabled = lutmgr_init_crt(&e->crt, e->settings.gamma, e->settings.scanlines, e->settings.mask,
+                                     e->settings.mask_level);
+
+    // Phosphor mode: fixed-point decay (the linear tables are built on first use)
+    float decay = e->settings.phosphor_decay;
+    decay = decay < 0.0f ? 0.0f : (decay > PHOSPHOR_DECAY_MAX ? PHOSPHOR_DECAY_MAX : decay);
+    e->settings.phosphor_decay = decay;
+    e->phosphor_k = (unsigned)(decay * PHOSPHOR_ONE + 0.5f);
+    return e;
+}
+
+void engine_destroy(engine_t *engine) {
+    delete engine;
+}
+
+const engine_settings_t *engine_settings(const engine_t *engine) {
+    return &engine->settings;
+}
+
+void engine_set_mode(engine_t *engine, int mode) {
+    // the accumulator is only kept up to date in phosphor mode and the
+    // periodicity signatures only in modes 1 and 2: start them over on the switch
+    const int old_mode = engine->settings.mode;
+    if (mode != old_mode) {
+        if (mode == PHOSPHOR_MODE)
+            engine->phosphor_valid = false;
+        if (old_mode == 0 || old_mode == PHOSPHOR_MODE)
+            std::fill(engine->period_state.begin(), engine->period_state.end(), 0);
+    }
+    engine->settings.mode = mode;
+}
+
+int engine_debug_view(const engine_t *engine) {
+    return engine->debug_view;
+}
+
+void engine_set_debug_view(engine_t *engine, int view) {
+    engine->debug_view = view;
+}
+
+void engine_set_class_stats(engine_t *engine, bool enable) {
+    engine->class_stats = enable;
+    memset(engine->class_pixels, 0, sizeof(engine->class_pixels));
+}
+
+const unsigned *engine_class_pixels(const engine_t *engine) {
+    return engine->class_pixels;
+}
+
+notification_t *engine_overlay(engine_t *engine) {
+    return &engine->overlay;
+}
+
+bool engine_resize(engine_t *engine, unsigned w, unsigned h) {
+    if (w == engine->w && h == engine->h)
+        return false;
+
+    engine->frame_size = w * h;
+    engine->frame_history.assign(engine->frame_size * FRAME_HISTORY, 0);
+    engine->period_state.assign(engine->frame_size, 0);
+    engine->phosphor_acc.clear(); // allocated by the first phosphor frame
+    engine->phosphor_valid = false;
+    engine->roi_valid = roi_init(&engine->roi, engine->settings.roi, w, h);
+    engine->have_prev = false; // history not initialized yet
+    engine->w = w;
+    engine->h = h;
+    engine->strip_rows = cache_strip_rows(w * ROW_BYTES_PER_PIXEL, engine->settings.strip_rows);
+    return true;
+}
+
+bool engine_roi_valid(const engine_t *engine) {
+    return engine->roi_valid;
+}
+
+unsigned engine_strip_rows(const engine_t *engine) {
+    return engine->strip_rows;
+}
+
+bool engine_ready(const engine_t *engine) {
+    return engine->have_prev;
+}
+
+// - Output helpers ------------------------------------------------------------
+
+// Apply CRT scanline/mask variant to an RGB565 pixel
+static inline WORD crt_apply(const crt_lut_t *crt, int variant, unsigned px) {
+    return (WORD)((crt->r5[variant][(px >> 11) & 0x1F] << 11) | (crt->g6[variant][(px >> 5) & 0x3F] << 5) |
+                  crt->b5[variant][px & 0x1F]);
+}
+
+// Write one source pixel as a 2x2 block; without CRT effects (crt == NULL)
+// the second row is copied by the caller once the whole row is done.
+static inline void put_pixel_2x(const crt_lut_t *crt, WORD *dst_row0, WORD *dst_row1, unsigned x, WORD px) {
+    if (crt) {
+        dst_row0[x * 2 + 0] = crt_apply(crt, 0, px);
+        dst_row0[x * 2 + 1] = crt_apply(crt, 1, px);
+        dst_row1[x * 2 + 0] = crt_apply(crt, 2, px);
+        dst_row1[x * 2 + 1] = crt_apply(crt, 3, px);
+    } else {
+        dst_row0[x * 2 + 0] = px;
+        dst_row0[x * 2 + 1] = px;
+    }
+}
+
+void engine_seed(engine_t *engine, const unsigned short *src, unsigned sp, unsigned short *dst, unsigned dp) {
+    const unsigned w = engine->w;
+    const unsigned frame_size = engine->frame_size;
+    const crt_lut_t *crt = engine->crt_enabled ? &engine->crt : NULL;
+    WORD *history = &engine->frame_history[0];
+
+    // First frame: pass-through 2x, also seed the history ring buffer.
+    for (unsigned y = 0; y < engine->h; ++y) {
+        const WORD *srow = src + y * sp;
+        WORD *drow0 = dst + (y * 2) * dp;
+        WORD *drow1 = drow0 + dp;
+
+        for (unsigned x = 0; x < w; ++x) {
+            WORD px = srow[x];
+            put_pixel_2x(crt, drow0, drow1, x, px);
+            // Initialize all history slots with the current frame
+            history[y * w + x + frame_size * 0] = px;
+            history[y * w + x + frame_size * 1] = px;
+            history[y * w + x + frame_size * 2] = px;
+            history[y * w + x + frame_size * 3] = px;
+            history[y * w + x + frame_size * 4] = px;
+        }
+        if (!crt)
+            std::memcpy(drow1, drow0, (w * 2) * sizeof(WORD));
+    }
+    engine->have_prev = true;
+}
+
+// - Frame renderer ------------------------------------------------------------
+// Source pixels per uniform-run check (border fast path)
+#define RUN_CHUNK 16
+
+// Row pointers for the current frame and the history slots (most recent first),
+// plus the settings the per-pixel code reads
+typedef struct {
+    const WORD *src;                 // frame N-0
+    const WORD *prev[FRAME_HISTORY]; // frames N-1 .. N-5
+    unsigned char *state;            // per-pixel periodicity signature
+    WORD *dst0;
+    WORD *dst1;
+    const crt_lut_t *crt; // NULL without CRT effects
+    const blend_params_t *bp;
+    int mode;
+    int motion_check;
+    unsigned period_confidence;
+    unsigned w;
+    motion_row_t motion; // row scroll (motion_check=2), zero otherwise
+    unsigned short *acc; // phosphor accumulator row (mode 3)
+    const phosphor_lut_t *phosphor;
+    unsigned phosphor_k;
+    int debug_view;
+    unsigned *class_pixels; // per-class counters, NULL unless statistics are on
+    bool classify;          // debug view or class counters active
+} row_ctx_t;
+
+// Update the periodicity signature of pixel x from p0 and the sample one
+// period ago. Only when the signature breaks is the history searched for the
+// shortest period that explains the last two values: p0 alone would take the
+// repeated neighbour of A,A,B,B for period 1 or 3 and never reach period 4.
+static inline unsigned period_update(unsigned state, WORD p0, const row_ctx_t &row, unsigned x) {
+    if (p0 == row.prev[PERIOD_OF(state) - 1][x])
+        return RUN_OF(state) < PERIOD_RUN_MAX ? state + PERIOD_RUN_ONE : state;
+
+    for (unsigned k = 1; k <= PERIOD_MAX; ++k) {
+        if (p0 == row.prev[k - 1][x] && row.prev[0][x] == row.prev[k][x])
+            return (k - 1) | PERIOD_RUN_ONE;
+    }
+    return 0; // period 1, no confirmed repeats
+}
+
+// Frame N-1 pixel to blend p0 with. With motion_check only pixels that
+// alternate with their partner (p0 == p2 != p1) are blended; on scrolled rows
+// p1 and p2 are sampled where the scroll moved the picture point from.
+static inline bool gigascreen_partner(const row_ctx_t &row, unsigned x, WORD p0, WORD *partner) {
+    if (!row.motion_check) {
+        *partner = row.prev[0][x];
+        return true;
+    }
+    const unsigned x1 = (unsigned)((int)x - row.motion.shift1);
+    const unsigned x2 = (unsigned)((int)x - row.motion.shift2);
+    if (x1 >= row.w || x2 >= row.w)
+        return false; // scrolled in from outside the row
+    *partner = row.prev[0][x1];
+    return p0 == row.prev[1][x2] && p0 != *partner;
+}
+
+// Gigascreen blend of p0, or p0 itself when motion_check rejects the pixel
+static inline WORD gigascreen_pixel(const row_ctx_t &row, unsigned x, WORD p0, unsigned *cls) {
+    WORD partner;
+    if (!gigascreen_partner(row, x, p0, &partner)) {
+        *cls = CLASS_MOTION;
+        return p0;
+    }
+    *cls = row.motion.shift1 || row.motion.shift2 ? CLASS_SCROLL : CLASS_GIGASCREEN;
+    return gigascreen_blend(*row.bp, p0, partner);
+}
+
+// Blend one pixel according to the current mode and update its signature;
+// *cls receives the path taken (debug view)
+static inline WORD blend_pixel(const row_ctx_t &row, unsigned x, unsigned *cls) {
+    const WORD p0 = row.src[x];     // pixel at frame N-0 (current)
+    const WORD p1 = row.prev[0][x]; // pixel at frame N-1
+    const WORD p2 = row.prev[1][x]; // pixel at frame N-2
+
+    const unsigned state = period_update(row.state[x], p0, row, x);
+    row.state[x] = (unsigned char)state;
+
+    // Mode 0: antiflicker is disabled (fallback option)
+    WORD out = p0;
+    unsigned period;
+    *cls = CLASS_PASS;
+
+    switch (row.mode) {
+    // Mode 2: antiflicker is enabled (Gigascreen + 3Color/4-phase)
+    case 2:
+        // skip static pixels
+        *cls = CLASS_STATIC;
+        if (p0 == p1 && p0 == p2)
+            break;
+
+        // blend over the detected period once it has repeated often enough
+        period = PERIOD_OF(state);
+        if (RUN_OF(state) >= row.period_confidence * period) {
+            // 3Color simple check
+            if (period == 3 && !rgb565_has_multi_component(p0) && !rgb565_has_multi_component(p1) &&
+                !rgb565_has_multi_component(p2)) {
+                out = tricolor_blend(*row.bp, p0, p1, p2);
+                *cls = CLASS_TRICOLOR;
+                break;
+            }
+            if (period == 4) {
+                out = quadcolor_blend(*row.bp, p0, p1, p2, row.prev[2][x]);
+                *cls = CLASS_QUADCOLOR;
+                break;
+            }
+        }
+
+        // fallback to Gigascreen mode
+        out = gigascreen_pixel(row, x, p0, cls);
+        break;
+
+    // Mode 1: antiflicker is enabled (Gigascreen only)
+    case 1:
+        // skip static pixels
+        *cls = CLASS_STATIC;
+        if (p0 == p1 && p0 == p2)
+            break;
+        out = gigascreen_pixel(row, x, p0, cls);
+        break;
+    }
+    return out;
+}
+
+// True if row[x .. x + RUN_CHUNK) is a single colour (64-bit compares)
+static inline bool chunk_uniform(const WORD *row, unsigned x) {
+    const unsigned long long pattern = row[x] * 0x0001000100010001ull;
+    for (unsigned i = 0; i < RUN_CHUNK; i += 4) {
+        unsigned long long v;
+        std::memcpy(&v, row + x + i, sizeof(v));
+        if (v != pattern)
+            return false;
+    }
+    return true;
+}
+
+// Fill n output pixel pairs starting at source column x with one value (wide stores)
+static inline void fill_2x(WORD *dst_row, unsigned x, unsigned n, WORD px0, WORD px1) {
+    const unsigned long long pattern = (px0 | ((unsigned)px1 << 16)) * 0x0000000100000001ull;
+    WORD *d = dst_row + x * 2;
+    unsigned i = 0;
+    for (; i + 2 <= n; i += 2)
+        std::memcpy(d + i * 2, &pattern, sizeof(pattern));
+    if (i < n) {
+        d[i * 2 + 0] = px0;
+        d[i * 2 + 1] = px1;
+    }
+}
+
+// Debug view: the class colour in place of the output pixel, or blended 50/50 over it
+static inline WORD debug_pixel(int view, unsigned cls, WORD out) {
+    const WORD color = s_class_colors[cls];
+    if (view == DEBUG_VIEW_REPLACE)
+        return color;
+    if (cls == CLASS_PASS)
+        return out;
+    return (WORD)(((out & 0xF7DE) >> 1) + ((color & 0xF7DE) >> 1));
+}
+
+// Count n pixels of class cls and apply the debug view to their output pixel
+static inline WORD classify_pixel(const row_ctx_t &row, unsigned cls, unsigned n, WORD out) {
+    if (row.class_pixels)
+        row.class_pixels[cls] += n;
+    return row.debug_view ? debug_pixel(row.debug_view, cls, out) : out;
+}
+
+// Write an output pixel of class cls as a 2x2 block (see put_pixel_2x)
+static inline void put_classified_2x(const row_ctx_t &row, unsigned x, WORD out, unsigned cls) {
+    if (row.classify)
+        out = classify_pixel(row, cls, 1, out);
+    put_pixel_2x(row.crt, row.dst0, row.dst1, x, out);
+}
+
+// Fill a uniform chunk at x with one output pixel of class cls
+static inline void fill_chunk_2x(const row_ctx_t &row, unsigned x, WORD out, unsigned cls) {
+    if (row.classify)
+        out = classify_pixel(row, cls, RUN_CHUNK, out);
+    if (row.crt) {
+        fill_2x(row.dst0, x, RUN_CHUNK, crt_apply(row.crt, 0, out), crt_apply(row.crt, 1, out));
+        fill_2x(row.dst1, x, RUN_CHUNK, crt_apply(row.crt, 2, out), crt_apply(row.crt, 3, out));
+    } else {
+        fill_2x(row.dst0, x, RUN_CHUNK, out, out);
+    }
+}
+
+// Pass-through copy of [x0, x1) (outside the region of interest)
+static inline void copy_span(const row_ctx_t &row, unsigned x0, unsigned x1) {
+    for (unsigned x = x0; x < x1; ++x)
+        put_classified_2x(row, x, row.src[x], CLASS_PASS);
+}
+
+// Blend [x0, x1). Chunks that are a single colour in the current frame and in
+// every history slot (typically the border) are classified once and filled;
+// their pixels share the signature of the first one. Scrolled rows sample the
+// history off-column, so they take the per-pixel path.
+static inline void blend_span(const row_ctx_t &row, unsigned x0, unsigned x1) {
+    unsigned x = x0;
+    bool have_run = false;
+    WORD run_key[FRAME_HISTORY + 2] = {0};
+    WORD run_out = 0;
+    unsigned run_cls = CLASS_PASS;
+    unsigned char run_state = 0;
+    unsigned cls;
+
+    const bool scrolled = row.motion.shift1 || row.motion.shift2;
+    for (; x + RUN_CHUNK <= x1; x += RUN_CHUNK) {
+        bool uniform = !scrolled && chunk_uniform(row.src, x);
+        for (int i = 0; uniform && i < FRAME_HISTORY; ++i)
+            uniform = chunk_uniform(row.prev[i], x);
+
+        if (uniform) {
+            // reuse the previous run's result while colours and signature stay the same
+            WORD key[FRAME_HISTORY + 2] = {row.src[x],     row.prev[0][x], row.prev[1][x], row.prev[2][x],
+                                           row.prev[3][x], row.prev[4][x], row.state[x]};
+            if (!have_run || std::memcmp(key, run_key, sizeof(key)) != 0) {
+                std::memcpy(run_key, key, sizeof(key));
+                run_out = blend_pixel(row, x, &run_cls);
+                run_state = row.state[x];
+                have_run = true;
+            }
+            std::memset(row.state + x, run_state, RUN_CHUNK);
+            fill_chunk_2x(row, x, run_out, run_cls);
+            continue;
+        }
+
+        for (unsigned i = x; i < x + RUN_CHUNK; ++i) {
+            WORD out = blend_pixel(row, i, &cls);
+            put_classified_2x(row, i, out, cls);
+        }
+    }
+
+    for (; x < x1; ++x) {
+        WORD out = blend_pixel(row, x, &cls);
+        put_classified_2x(row, x, out, cls);
+    }
+}
+
+// One decay step of an accumulator channel towards target t. Near the target
+// the rounded step becomes zero (for (1 - k) * |t - a| < 1/2 unit, several
+// units away at high decays) and the value would stick there; it snaps to t
+// instead, so a converged pixel matches the settled check below exactly.
+static inline unsigned phosphor_step(unsigned a, unsigned t, unsigned k, unsigned ik) {
+    const unsigned v = (a * k + t * ik + PHOSPHOR_ONE / 2) >> 8;
+    return v == a ? t : v;
+}
+
+// Phosphor mode: acc = acc * k + p0 * (1 - k) per channel in 16-bit linear
+// light, shown through the forward table. Any flicker period is smoothed with
+// one accumulator read and write per pixel; the history is not read.
+static inline WORD phosphor_pixel(const row_ctx_t &row, unsigned x) {
+    const phosphor_lut_t *lut = row.phosphor;
+    const unsigned k = row.phosphor_k;
+    const unsigned ik = PHOSPHOR_ONE - k;
+    const unsigned shift = 16 - PHOSPHOR_FWD_BITS;
+
+    const WORD p0 = row.src[x];
+    unsigned short *acc = row.acc + x * 3;
+    unsigned r = phosphor_step(acc[0], lut->rev_5b[(p0 >> 11) & 0x1F], k, ik);
+    unsigned g = phosphor_step(acc[1], lut->rev_6b[(p0 >> 5) & 0x3F], k, ik);
+    unsigned b = phosphor_step(acc[2], lut->rev_5b[p0 & 0x1F], k, ik);
+    acc[0] = (unsigned short)r;
+    acc[1] = (unsigned short)g;
+    acc[2] = (unsigned short)b;
+    return (WORD)((lut->fwd_5b[r >> shift] << 11) | (lut->fwd_6b[g >> shift] << 5) | lut->fwd_5b[b >> shift]);
+}
+
+// True if the accumulator of [x, x + RUN_CHUNK) holds one value equal to p0
+// (converged), so the update is a no-op for the whole chunk
+static inline bool phosphor_chunk_settled(const row_ctx_t &row, unsigned x, WORD p0) {
+    const phosphor_lut_t *lut = row.phosphor;
+    const unsigned short *acc = row.acc + x * 3;
+    return acc[0] == lut->rev_5b[(p0 >> 11) & 0x1F] && acc[1] == lut->rev_6b[(p0 >> 5) & 0x3F] &&
+           acc[2] == lut->rev_5b[p0 & 0x1F] && std::memcmp(acc, acc + 3, (RUN_CHUNK - 1) * 3 * sizeof(*acc)) == 0;
+}
+
+// Phosphor blend of [x0, x1); settled single-colour chunks (typically the
+// border) are computed once and filled
+static inline void phosphor_span(const row_ctx_t &row, unsigned x0, unsigned x1) {
+    unsigned x = x0;
+    for (; x + RUN_CHUNK <= x1; x += RUN_CHUNK) {
+        if (chunk_uniform(row.src, x) && phosphor_chunk_settled(row, x, row.src[x])) {
+            fill_chunk_2x(row, x, phosphor_pixel(row, x), CLASS_STATIC);
+            continue;
+        }
+
+        for (unsigned i = x; i < x + RUN_CHUNK; ++i)
+            put_classified_2x(row, i, phosphor_pixel(row, i), CLASS_PHOSPHOR);
+    }
+
+    for (; x < x1; ++x)
+        put_classified_2x(row, x, phosphor_pixel(row, x), CLASS_PHOSPHOR);
+}
+
+// Start the accumulator from the current frame (first phosphor frame). The
+// high-precision linear tables are only built here, so configurations that
+// never enter mode 3 do not pay for them.
+static void phosphor_seed(engine_t *engine, const WORD *src, unsigned sp) {
+    if (!engine->phosphor_lut_ready) {
+        lutmgr_init_phosphor(&engine->phosphor, engine->settings.gamma);
+        engine->phosphor_lut_ready = true;
+    }
+
+    const phosphor_lut_t *lut = &engine->phosphor;
+    engine->phosphor_acc.resize(engine->frame_size * 3);
+    unsigned short *acc = &engine->phosphor_acc[0];
+    for (unsigned y = 0; y < engine->h; ++y) {
+        for (unsigned x = 0; x < engine->w; ++x, acc += 3) {
+            const WORD p = src[y * sp + x];
+            acc[0] = lut->rev_5b[(p >> 11) & 0x1F];
+            acc[1] = lut->rev_6b[(p >> 5) & 0x3F];
+            acc[2] = lut->rev_5b[p & 0x1F];
+        }
+    }
+    engine->phosphor_valid = true;
+}
+
+// Prefetch the inputs of row y (source, every history plane, signatures and
+// the phosphor accumulator when in use; only the source in mode 0)
+static inline void prefetch_row(const engine_t *engine, const WORD *src, unsigned sp, unsigned y) {
+    const unsigned w = engine->w;
+    cache_prefetch(src + y * sp, w * sizeof(WORD));
+    if (engine->settings.mode == 0)
+        return;
+    for (unsigned i = 0; i < FRAME_HISTORY; ++i)
+        cache_prefetch(&engine->frame_history[y * w + engine->frame_size * i], w * sizeof(WORD));
+    cache_prefetch(&engine->period_state[y * w], w);
+    if (engine->settings.mode == PHOSPHOR_MODE)
+        cache_prefetch(&engine->phosphor_acc[y * w * 3], w * 3 * sizeof(WORD));
+}
+
+// Blends one frame against the history and writes the 2x output. Runs on the
+// render thread, or on the pipeline worker when pipelined mode is enabled.
+void engine_render(engine_t *engine, const unsigned short *src, unsigned sp, unsigned short *dst, unsigned dp) {
+    const unsigned w = engine->w;
+    const unsigned frame_size = engine->frame_size;
+    const unsigned last_frame_idx = engine->last_frame_idx;
+    WORD *history = &engine->frame_history[0];
+
+    // Compute indices into the frame history ring buffer (most recent first)
+    int idx_p0 = last_frame_idx;                       // N-1 (most recent stored)
+    int idx_p1 = (last_frame_idx + 1) % FRAME_HISTORY; // N-2
+    int idx_p2 = (last_frame_idx + 2) % FRAME_HISTORY; // N-3
+    int idx_p3 = (last_frame_idx + 3) % FRAME_HISTORY; // N-4
+    int idx_p4 = (last_frame_idx + 4) % FRAME_HISTORY; // N-5
+
+    // Advance write position for the next frame to be stored
+    engine->last_frame_idx = (last_frame_idx + FRAME_HISTORY - 1) % FRAME_HISTORY;
+
+    row_ctx_t row;
+    row.crt = engine->crt_enabled ? &engine->crt : NULL;
+    row.bp = &engine->blend_params;
+    row.mode = engine->settings.mode;
+    row.motion_check = engine->settings.motion_check;
+    row.period_confidence = engine->settings.period_confidence;
+    row.w = w;
+    row.phosphor = &engine->phosphor;
+    row.phosphor_k = engine->phosphor_k;
+    row.debug_view = engine->debug_view;
+    row.class_pixels = engine->class_stats ? engine->class_pixels : NULL;
+    row.classify = row.debug_view || row.class_pixels;
+    if (row.class_pixels)
+        memset(row.class_pixels, 0, sizeof(engine->class_pixels));
+    if (row.mode == PHOSPHOR_MODE && !engine->phosphor_valid)
+        phosphor_seed(engine, src, sp);
+
+    // Blend per-pixel according to the current mode, then 2x replicate. Rows
+    // are walked in strips: while row y is blended, row y + strip_rows is
+    // prefetched, so the next strip is in cache when it is reached.
+    const unsigned strip_rows = engine->strip_rows;
+    for (unsigned y = 0; y < engine->h; ++y) {
+        if (y + strip_rows < engine->h)
+            prefetch_row(engine, src, sp, y + strip_rows);
+
+        row.src = src + y * sp;
+        row.dst0 = dst + (y * 2) * dp;
+        row.dst1 = row.dst0 + dp;
+        row.prev[0] = &history[y * w + frame_size * idx_p0];
+        row.prev[1] = &history[y * w + frame_size * idx_p1];
+        row.prev[2] = &history[y * w + frame_size * idx_p2];
+        row.prev[3] = &history[y * w + frame_size * idx_p3];
+        row.prev[4] = &history[y * w + frame_size * idx_p4];
+        row.state = &engine->period_state[y * w];
+        row.acc = row.mode == PHOSPHOR_MODE ? &engine->phosphor_acc[y * w * 3] : NULL;
+
+        if (row.mode == 0) {
+            // disabled: plain 2x copy, the signatures are not updated (see engine_set_mode)
+            copy_span(row, 0, w);
+        } else {
+            // blend inside the region of interest, pass the rest through
+            const unsigned short *spans;
+            unsigned count = roi_row_spans(&engine->roi, y, &spans);
+
+            // row scroll search, only for rows that changed against frame N-2;
+            // phosphor mode does not read the history, so it has no use for it
+            if (row.motion_check == 2 && row.mode != PHOSPHOR_MODE && count)
+                motion_estimate_row(row.src, row.prev[0], row.prev[1], w, &row.motion);
+            else
+                row.motion.shift1 = row.motion.shift2 = 0;
+
+            unsigned x = 0;
+            for (unsigned i = 0; i < count; ++i) {
+                copy_span(row, x, spans[i * 2]);
+                if (row.mode == PHOSPHOR_MODE)
+                    phosphor_span(row, spans[i * 2], spans[i * 2 + 1]);
+                else
+                    blend_span(row, spans[i * 2], spans[i * 2 + 1]);
+                x = spans[i * 2 + 1];
+            }
+            copy_span(row, x, w);
+        }
+
+        // store current row in the newest history slot (replaces the oldest one)
+        std::memcpy(&history[y * w + frame_size * idx_p4], row.src, w * sizeof(WORD));
+
+        // copy every full row (CRT variants are written per pixel)
+        if (!row.crt)
+            std::memcpy(row.dst1, row.dst0, (w * 2) * sizeof(WORD));
+    }
+}
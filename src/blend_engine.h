@@ -0,0 +1,108 @@
+#pragma once
+
+#include "notifications_manager.h"
+
+// Default configuration values
+#define DEFAULT_MODE 2
+#define DEFAULT_GAMMA 2.2
+#define DEFAULT_RATIO 0.5
+#define DEFAULT_FULLBRIGHT 0
+#define DEFAULT_MOTION_DETECTION 0
+#define DEFAULT_PERIOD_CONFIDENCE 1
+#define DEFAULT_SHOW_BANNER 1
+#define DEFAULT_SCANLINES 0.0
+#define DEFAULT_MASK 0
+#define DEFAULT_MASK_LEVEL 0.25
+#define DEFAULT_PHOSPHOR_DECAY 0.5
+#define DEFAULT_STRIP_ROWS 0 // 0 = from the L2 cache size
+
+// Modes (Shift+Tab cycles through them)
+#define MODE_COUNT 4
+
+// Debug views (Ctrl+Shift+Tab cycles through them): the path each pixel took
+// as a colour, blended over the picture or in place of it
+#define DEBUG_VIEW_OFF 0
+#define DEBUG_VIEW_OVERLAY 1
+#define DEBUG_VIEW_REPLACE 2
+#define DEBUG_VIEW_COUNT 3
+
+// Pixel classes (debug view, statistics): which path produced the output pixel
+enum {
+    CLASS_PASS,       // not processed (mode 0, outside the region of interest)
+    CLASS_STATIC,     // unchanged over the last frames (or settled phosphor)
+    CLASS_GIGASCREEN, // 2-frame blend
+    CLASS_SCROLL,     // 2-frame blend with a motion-compensated partner
+    CLASS_TRICOLOR,   // 3Color blend
+    CLASS_QUADCOLOR,  // 4-phase blend
+    CLASS_MOTION,     // rejected by motion_check, shown unblended
+    CLASS_PHOSPHOR,   // phosphor accumulator update
+    CLASS_COUNT
+};
+
+// Blending settings of one engine (gigascreen.cfg keys of the same name)
+typedef struct {
+    float gamma;
+    float ratio;
+    int mode;
+    int fullbright;
+    int motion_check;
+    unsigned period_confidence;
+    int show_banner;
+    float scanlines;
+    int mask;
+    float mask_level;
+    float phosphor_decay;
+    int strip_rows;
+    char roi[128];
+} engine_settings_t;
+
+// Engine: one independent frame stream (history, periodicity state, region of
+// interest, CRT tables, overlay). LUT sets are shared read-only between
+// engines, so any number of them can run concurrently, one per thread.
+// A single engine is not thread-safe.
+typedef struct engine_t engine_t;
+
+void engine_default_settings(engine_settings_t *settings);
+
+// Defaults overridden by the loaded config file (cfg_init)
+void engine_load_settings(engine_settings_t *settings);
+
+engine_t *engine_create(const engine_settings_t *settings);
+void engine_destroy(engine_t *engine);
+
+const engine_settings_t *engine_settings(const engine_t *engine);
+void engine_set_mode(engine_t *engine, int mode);
+
+int engine_debug_view(const engine_t *engine);
+void engine_set_debug_view(engine_t *engine, int view);
+
+// Count output pixels per class while rendering (live statistics)
+void engine_set_class_stats(engine_t *engine, bool enable);
+
+// Pixels per class in the last rendered frame (CLASS_COUNT entries, zero
+// unless enabled). Not synchronized: read between frames.
+const unsigned *engine_class_pixels(const engine_t *engine);
+
+// Prepare for w x h frames. A size change drops the history; returns true then.
+bool engine_resize(engine_t *engine, unsigned w, unsigned h);
+
+// False if the roi setting could not be fully parsed for the current frame
+// size (see roi_init: the valid part, or the whole frame, is blended)
+bool engine_roi_valid(const engine_t *engine);
+
+// Rows per render strip (prefetch distance) for the current frame size
+unsigned engine_strip_rows(const engine_t *engine);
+
+// True once the history has been seeded by a first frame
+bool engine_ready(const engine_t *engine);
+
+// First frame: pass-through 2x and seed every history slot with it
+void engine_seed(engine_t *engine, const unsigned short *src, unsigned src_pitch, unsigned short *dst,
+                 unsigned dst_pitch);
+
+// Blend one frame against the history and write the 2x output (pitches in pixels)
+void engine_render(engine_t *engine, const unsigned short *src, unsigned src_pitch, unsigned short *dst,
+                   unsigned dst_pitch);
+
+// Notification overlay of this engine
+notification_t *engine_overlay(engine_t *engine);
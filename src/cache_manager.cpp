@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// Cache parameters for Gigascreen Render Plugin
+//
+// The renderer walks the frame in strips of rows and prefetches the strip
+// ahead of the current one, so the next rows of the source, the five history
+// planes and the periodicity signatures are in cache by the time they are
+// blended while the LUTs stay resident. The strip height comes from the L2
+// size reported by CPUID (older 32-bit machines often have 256-512 KB) or
+// from the strip_rows config key.
+//------------------------------------------------------------------------------
+
+#include "cache_manager.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define CACHE_HAVE_CPUID
+static void cpuid(unsigned leaf, unsigned sub, unsigned regs[4]) {
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)sub);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = (unsigned)r[i];
+}
+#elif defined(__i386__) || defined(__x86_64__)
+#include <cpuid.h>
+#define CACHE_HAVE_CPUID
+static void cpuid(unsigned leaf, unsigned sub, unsigned regs[4]) {
+    __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+}
+#endif
+
+#define CACHE_L2_FALLBACK (256 * 1024)
+
+static unsigned detect_l2_size(void) {
+#ifdef CACHE_HAVE_CPUID
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    const unsigned max_leaf = regs[0];
+
+    // leaf 4: one sub-leaf per cache, type 0 terminates the list
+    unsigned best = 0;
+    for (unsigned sub = 0; max_leaf >= 4 && sub < 16; ++sub) {
+        cpuid(4, sub, regs);
+        const unsigned type = regs[0] & 0x1F; // 1 = data, 2 = instruction, 3 = unified
+        if (type == 0)
+            break;
+        const unsigned level = (regs[0] >> 5) & 0x7;
+        if (level != 2 || type == 2)
+            continue;
+        const unsigned ways = (regs[1] >> 22) + 1;
+        const unsigned partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+        const unsigned line = (regs[1] & 0xFFF) + 1;
+        const unsigned sets = regs[2] + 1;
+        best = ways * partitions * line * sets;
+    }
+    if (best)
+        return best;
+
+    // AMD (and older Intel): L2 size in KB in ECX[31:16]
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x80000006) {
+        cpuid(0x80000006, 0, regs);
+        if (regs[2] >> 16)
+            return (regs[2] >> 16) * 1024;
+    }
+#endif
+    return CACHE_L2_FALLBACK;
+}
+
+unsigned cache_l2_size(void) {
+    static const unsigned s_l2 = detect_l2_size();
+    return s_l2;
+}
+
+unsigned cache_strip_rows(unsigned row_bytes, int configured) {
+    unsigned rows = configured > 0 ? (unsigned)configured : cache_l2_size() / 4 / (row_bytes ? row_bytes : 1);
+    if (rows < STRIP_ROWS_MIN)
+        rows = STRIP_ROWS_MIN;
+    if (rows > STRIP_ROWS_MAX)
+        rows = STRIP_ROWS_MAX;
+    return rows;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define CACHE_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define CACHE_PREFETCH(p) ((void)(p))
+#endif
+
+#define CACHE_LINE 64
+
+// Strip height limits (rows processed ahead of the prefetch front)
+#define STRIP_ROWS_MIN 1
+#define STRIP_ROWS_MAX 64
+
+// L2 cache size in bytes from CPUID: deterministic cache parameters (leaf 4),
+// AMD extended leaf 0x80000006, or a 256 KB fallback. Detected once.
+unsigned cache_l2_size(void);
+
+// Strip height for rows of row_bytes (all streams a row touches): the
+// configured value if non-zero, otherwise what keeps two strips within half
+// of the L2 cache
+unsigned cache_strip_rows(unsigned row_bytes, int configured);
+
+// Touch every cache line of [p, p + bytes)
+static inline void cache_prefetch(const void *p, size_t bytes) {
+    const char *c = (const char *)p;
+    for (size_t i = 0; i < bytes; i += CACHE_LINE)
+        CACHE_PREFETCH(c + i);
+}
@@ -0,0 +1,233 @@
+//------------------------------------------------------------------------------
+// Video capture for Gigascreen Render Plugin
+//
+// Records the blended output to a .y4m (YUV4MPEG2, 4:2:0, 50 fps) file.
+// The render thread only copies each finished frame into a preallocated ring
+// buffer; a background writer converts RGB565 to YUV and streams it to disk.
+// If the writer falls behind, new frames are dropped and counted instead of
+// blocking the render call.
+//
+// Every recording session owns its ring buffer and writer thread. On stop the
+// writer drains the queue, closes the file and frees the session itself, so
+// the render thread never waits for the disk.
+//------------------------------------------------------------------------------
+
+#include "capture_manager.h"
+#include "platform.h"
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// writer wakes up at least this often (milliseconds)
+#define CAPTURE_POLL_INTERVAL 100
+
+typedef struct {
+    unsigned w;
+    unsigned h;
+    unsigned slots;
+    std::vector<WORD> frames;    // slots * w * h, RGB565
+    std::atomic<unsigned> head;  // frames queued (render thread)
+    std::atomic<unsigned> tail;  // frames written (writer thread)
+    std::atomic<bool> stop;
+    HANDLE wake;
+    FILE *f;
+    HMODULE module;
+} capture_session_t;
+
+static capture_session_t *s_session = NULL; // active session (render thread only)
+static unsigned s_dropped = 0;              // dropped frames in the active session
+static unsigned s_queued = 0;               // queued frames in the active session
+static std::atomic<unsigned> s_writers(0);  // writer threads not yet finished
+
+// - Writer --------------------------------------------------------------------
+
+static inline unsigned char clamp_u8(int v) {
+    return (unsigned char)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+// RGB565 -> BT.601 limited range YUV 4:2:0
+static void convert_yuv420(const WORD *src, unsigned w, unsigned h, unsigned char *yuv) {
+    const unsigned cw = (w + 1) / 2, ch = (h + 1) / 2;
+    unsigned char *py = yuv;
+    unsigned char *pu = yuv + w * h;
+    unsigned char *pv = pu + cw * ch;
+
+    for (unsigned y = 0; y < h; y += 2) {
+        for (unsigned x = 0; x < w; x += 2) {
+            int sum_r = 0, sum_g = 0, sum_b = 0, n = 0;
+            for (unsigned dy = 0; dy < 2 && y + dy < h; ++dy) {
+                for (unsigned dx = 0; dx < 2 && x + dx < w; ++dx) {
+                    const unsigned c = src[(y + dy) * w + x + dx];
+                    const int r = ((c >> 11) & 0x1F) * 255 / 31;
+                    const int g = ((c >> 5) & 0x3F) * 255 / 63;
+                    const int b = (c & 0x1F) * 255 / 31;
+                    py[(y + dy) * w + x + dx] = clamp_u8(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                    sum_r += r;
+                    sum_g += g;
+                    sum_b += b;
+                    ++n;
+                }
+            }
+            const int r = sum_r / n, g = sum_g / n, b = sum_b / n;
+            pu[(y / 2) * cw + x / 2] = clamp_u8(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            pv[(y / 2) * cw + x / 2] = clamp_u8(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+static DWORD WINAPI capture_writer(LPVOID param) {
+    capture_session_t *s = (capture_session_t *)param;
+    const unsigned frame_size = s->w * s->h;
+    std::vector<unsigned char> yuv(frame_size + 2 * ((s->w + 1) / 2) * ((s->h + 1) / 2));
+    bool failed = false;
+
+    for (;;) {
+        // read stop before head: frames queued before stop are always seen.
+        // head is read seq_cst against the tail store below: either this load
+        // sees a frame queued right after the queue ran empty, or
+        // capture_frame() sees the empty queue and signals the wake event.
+        const bool stopping = s->stop.load(std::memory_order_acquire);
+        const unsigned tail = s->tail.load(std::memory_order_relaxed);
+        if (tail == s->head.load(std::memory_order_seq_cst)) {
+            if (stopping)
+                break;
+            WaitForSingleObject(s->wake, CAPTURE_POLL_INTERVAL);
+            continue;
+        }
+
+        if (!failed) {
+            convert_yuv420(&s->frames[(tail % s->slots) * frame_size], s->w, s->h, &yuv[0]);
+            failed = fputs("FRAME\n", s->f) < 0 || fwrite(&yuv[0], 1, yuv.size(), s->f) != yuv.size();
+        }
+        s->tail.store(tail + 1, std::memory_order_seq_cst);
+    }
+
+    fclose(s->f);
+    CloseHandle(s->wake);
+    HMODULE self = s->module;
+    delete s;
+
+    // last access to shared state: capture_wait() may return right after this
+    s_writers.fetch_sub(1, std::memory_order_release);
+    FreeLibraryAndExitThread(self, 0);
+    return 0;
+}
+
+// - Public API ----------------------------------------------------------------
+
+bool capture_start(const char *path, unsigned w, unsigned h, unsigned buffer_frames) {
+    if (s_session || !w || !h)
+        return false;
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    fprintf(f, "YUV4MPEG2 W%u H%u F50:1 Ip A1:1 C420jpeg\n", w, h);
+
+    capture_session_t *s = new capture_session_t();
+    s->w = w;
+    s->h = h;
+    s->slots = buffer_frames < 2 ? 2 : buffer_frames;
+    s->frames.assign(s->slots * w * h, 0);
+    s->head = 0;
+    s->tail = 0;
+    s->stop = false;
+    s->f = f;
+    s->wake = CreateEventA(NULL, FALSE, FALSE, NULL);
+
+    // the writer keeps the DLL loaded until the file is closed
+    HANDLE thread = NULL;
+    if (s->wake && GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCSTR)&capture_writer, &s->module)) {
+        s_writers.fetch_add(1, std::memory_order_relaxed);
+        thread = CreateThread(NULL, 0, capture_writer, s, 0, NULL);
+        if (!thread) {
+            s_writers.fetch_sub(1, std::memory_order_relaxed);
+            FreeLibrary(s->module);
+        }
+    }
+    if (!thread) {
+        if (s->wake)
+            CloseHandle(s->wake);
+        fclose(f);
+        delete s;
+        return false;
+    }
+    SetThreadPriority(thread, THREAD_PRIORITY_BELOW_NORMAL);
+    CloseHandle(thread);
+
+    s_session = s;
+    s_dropped = 0;
+    s_queued = 0;
+    return true;
+}
+
+unsigned capture_stop(void) {
+    if (!s_session)
+        return 0;
+    // the writer owns the session from here on (it polls, no wake-up needed:
+    // the session may already be gone right after the store)
+    s_session->stop.store(true, std::memory_order_release);
+    s_session = NULL;
+    return s_dropped;
+}
+
+void capture_wait(void) {
+    capture_stop();
+    while (s_writers.load(std::memory_order_acquire))
+        Sleep(1);
+}
+
+bool capture_active(void) {
+    return s_session != NULL;
+}
+
+// Per-channel average of a 2x2 block of the 2x output. Without CRT effects
+// the four pixels are equal; with them this evens out the per-pixel mask tint.
+static inline WORD average_2x2(WORD a, WORD b, WORD c, WORD d) {
+    const unsigned r = ((a >> 11) + (b >> 11) + (c >> 11) + (d >> 11) + 2) >> 2;
+    const unsigned g = (((a >> 5) & 0x3F) + ((b >> 5) & 0x3F) + ((c >> 5) & 0x3F) + ((d >> 5) & 0x3F) + 2) >> 2;
+    const unsigned bl = ((a & 0x1F) + (b & 0x1F) + (c & 0x1F) + (d & 0x1F) + 2) >> 2;
+    return (WORD)((r << 11) | (g << 5) | bl);
+}
+
+void capture_frame(const unsigned short *src, unsigned pitch, unsigned step) {
+    capture_session_t *s = s_session;
+    if (!s)
+        return;
+
+    const unsigned head = s->head.load(std::memory_order_relaxed);
+    if (head - s->tail.load(std::memory_order_acquire) >= s->slots) {
+        ++s_dropped; // writer is behind: never block the render call
+        return;
+    }
+
+    WORD *dst = &s->frames[(head % s->slots) * s->w * s->h];
+    for (unsigned y = 0; y < s->h; ++y) {
+        const WORD *row = src + y * step * pitch;
+        if (step == 1) {
+            memcpy(dst + y * s->w, row, s->w * sizeof(WORD));
+        } else {
+            const WORD *row1 = row + pitch;
+            for (unsigned x = 0; x < s->w; ++x)
+                dst[y * s->w + x] = average_2x2(row[x * 2], row[x * 2 + 1], row1[x * 2], row1[x * 2 + 1]);
+        }
+    }
+
+    s->head.store(head + 1, std::memory_order_seq_cst);
+    ++s_queued;
+
+    // wake the writer only if it may be waiting: the queue was empty before
+    // this frame. While it has frames queued it does not wait, so most
+    // frames cost no system call.
+    if (s->tail.load(std::memory_order_seq_cst) == head)
+        SetEvent(s->wake);
+}
+
+unsigned capture_frames_queued(void) {
+    return s_queued;
+}
+
+unsigned capture_frames_dropped(void) {
+    return s_dropped;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// Start recording .y4m into the given file. Frames are w x h RGB565.
+bool capture_start(const char *path, unsigned w, unsigned h, unsigned buffer_frames);
+
+// Stop recording; the writer drains queued frames in the background.
+// Returns the number of frames dropped during the session.
+unsigned capture_stop(void);
+
+// Stop recording and wait until every writer has closed its file (not from
+// DllMain; the plugin itself relies on the writers' DLL reference instead).
+void capture_wait(void);
+
+bool capture_active(void);
+
+// Queue a finished frame (never blocks; drops the frame if the writer is behind).
+// step = 2 averages every 2x2 block (1x frame from the 2x output).
+void capture_frame(const unsigned short *src, unsigned pitch, unsigned step);
+
+unsigned capture_frames_queued(void);
+unsigned capture_frames_dropped(void);
@@ -12,17 +12,28 @@
 // motion_check=0
 // fullbright=0
 // show_banner=1
+// scanlines=0.0
+// mask=0
+// mask_level=0.25
+// pipeline=0
+// period_confidence=1
+// phosphor_decay=0.5
+// roi=all
+// strip_rows=0
+// capture_scale=1
+// capture_buffer=64
+// capture_dir=
+// stats=0
 //
 // Check README.md for more details.
 //------------------------------------------------------------------------------
 
-#define WIN32_LEAN_AND_MEAN
 #include "config_manager.h"
+#include "platform.h"
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <windows.h>
 
 #define CFG_MAX_ENTRIES 32
 #define CFG_KEY_MAX 64
@@ -73,15 +84,6 @@ static void get_dll_dir(char out_dir[MAX_PATH]) {
     }
 }
 
-static void join_path(char out[MAX_PATH], const char *dir, const char *name) {
-    if (!dir || !*dir) {
-        strncpy(out, name, MAX_PATH - 1);
-        out[MAX_PATH - 1] = 0;
-        return;
-    }
-    _snprintf(out, MAX_PATH, "%s\\%s", dir, name);
-}
-
 static bool write_text_file(const char *path, const char *text) {
     FILE *f = fopen(path, "wb");
     if (!f)
@@ -173,11 +175,15 @@ static const cfg_entry_t *find_entry(const char *key) {
 bool cfg_init(const char *filename) {
     char dir[MAX_PATH] = {0};
     get_dll_dir(dir);
-    join_path(s_path, dir, filename ? filename : "gigascreen.cfg");
+    if (!cfg_join_path(dir, filename ? filename : "gigascreen.cfg", s_path, sizeof(s_path)))
+        return false;
 
     FILE *f = fopen(s_path, "rb");
     if (!f) {
-        const char *defaults = "mode=2\ngamma=2.2\nratio=0.5\nmotion_check=0\nfullbright=0\nshow_banner=1\n";
+        const char *defaults = "mode=2\ngamma=2.2\nratio=0.5\nmotion_check=0\nfullbright=0\nshow_banner=1\n"
+                               "scanlines=0.0\nmask=0\nmask_level=0.25\npipeline=0\n"
+                               "period_confidence=1\nphosphor_decay=0.5\nroi=all\nstrip_rows=0\n"
+                               "capture_scale=1\ncapture_buffer=64\ncapture_dir=\nstats=0\n";
         if (!write_text_file(s_path, defaults))
             return false;
     } else {
@@ -229,3 +235,38 @@ int cfg_get_int(const char *key, int fallback) {
         return fallback;
     return (int)v;
 }
+
+const char *cfg_get_str(const char *key, const char *fallback) {
+    if (!s_inited)
+        return fallback;
+
+    const cfg_entry_t *e = find_entry(key);
+    if (!e || !*e->val)
+        return fallback;
+    return e->val;
+}
+
+// dir + '\\' + name; no separator is added after an empty dir or one that
+// already ends in a slash. On truncation out is left empty.
+bool cfg_join_path(const char *dir, const char *name, char *out, int size) {
+    const size_t dir_len = dir ? strlen(dir) : 0;
+    const size_t name_len = strlen(name);
+    const size_t sep = dir_len && dir[dir_len - 1] != '\\' && dir[dir_len - 1] != '/';
+    if (size <= 0 || dir_len + sep + name_len >= (size_t)size) {
+        if (size > 0)
+            out[0] = 0;
+        return false;
+    }
+    memcpy(out, dir, dir_len);
+    if (sep)
+        out[dir_len] = '\\';
+    memcpy(out + dir_len + sep, name, name_len + 1);
+    return true;
+}
+
+// Full path of a file placed next to the plugin DLL
+bool cfg_get_path(const char *filename, char *out, int size) {
+    char dir[MAX_PATH] = {0};
+    get_dll_dir(dir);
+    return cfg_join_path(dir, filename, out, size);
+}
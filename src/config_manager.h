@@ -3,3 +3,8 @@
 bool cfg_init(const char *filename);
 float cfg_get_float(const char *key, float fallback);
 int cfg_get_int(const char *key, int fallback);
+const char *cfg_get_str(const char *key, const char *fallback);
+
+// Path helpers: false (and an empty out) if the result does not fit in size chars
+bool cfg_join_path(const char *dir, const char *name, char *out, int size);
+bool cfg_get_path(const char *filename, char *out, int size);
@@ -5,13 +5,18 @@
 //
 // Simple temporal-blend render plugin (2x) for Spectaculator and ZXSpin.
 // Blends 16bpp frames (RGB565) using precomputed LUTs and outputs
-// a 2x image. Exports are provided by rpi.h.
-// Supports Gigascreen (2-frame) and experimental 3Color (3-frame) modes.
+// a 2x image. Exports are provided by rpi.h. The blending itself lives in
+// blend_engine.cpp; this file wraps one default engine instance and adds
+// the plugin-level services (config, hotkeys, pipelining, capture).
+// Supports Gigascreen (2-frame), experimental 3Color (3-frame) and phosphor
+// persistence modes.
 //
 // Platform support:
 // - Windows (Win32/x86) only.
 //   This code uses WinAPI (windows.h, DllMain) and is not portable as-is
-//   to other platforms.
+//   to other platforms. The only exception is the offline benchmark harness
+//   (tools/gigascreen_bench.cpp), which builds these sources on Linux against
+//   the small WinAPI subset emulated in platform.h.
 // - macOS builds are NOT supported, as I currently have no ability to build
 //   or test the plugin on macOS.
 //
@@ -27,13 +32,20 @@
 //   controlled via a text config file (gigascreen.cfg) placed next to the DLL.
 //------------------------------------------------------------------------------
 
+#include "blend_engine.h"
+#include "capture_manager.h"
 #include "config_manager.h"
-#include "lut_manager.h"
+#include "input_manager.h"
 #include "notifications_manager.h"
+#include "pipeline_manager.h"
+#include "platform.h"
 #include "rpi.h"
+#include "stage_profiler.h"
+#include "stats_manager.h"
+#include <atomic>
 #include <cstring>
-#include <vector>
-#include <windows.h>
+#include <stdio.h>
+#include <time.h>
 
 #ifndef PLUGIN_TITLE
 #define PLUGIN_TITLE "Gigascreen No-Flick (.koval)"
@@ -42,134 +54,167 @@
 #define PLUGIN_VERSION "1.2"
 #endif
 
-// Default configuration values
-#define DEFAULT_MODE 2
-#define DEFAULT_GAMMA 2.2
-#define DEFAULT_RATIO 0.5
-#define DEFAULT_FULLBRIGHT 0
-#define DEFAULT_MOTION_DETECTION 0
-#define DEFAULT_SHOW_BANNER 1
-
-// Keep last N-frames for 3Color mode evaluation
-#define FRAME_HISTORY 5
-
-static std::vector<WORD> frame_history; // ring buffer for frame history
-static unsigned frame_size = 0;
-static unsigned last_frame_idx = 0;
-static unsigned s_w = 0;
-static unsigned s_h = 0;
-static bool s_havePrev = false;
-static float gamma = DEFAULT_GAMMA;
-static float ratio = DEFAULT_RATIO;
-static int mode = DEFAULT_MODE;
-static int fullbright = DEFAULT_FULLBRIGHT;
-static int motion_check = DEFAULT_MOTION_DETECTION;
-static int show_banner = DEFAULT_SHOW_BANNER;
-
-static lut5_ptr lut_blend_5b = nullptr;
-static lut6_ptr lut_blend_6b = nullptr;
+// Default configuration values (blending defaults are in blend_engine.h)
+#define DEFAULT_PIPELINE 0
+#define DEFAULT_CAPTURE_SCALE 1
+#define DEFAULT_CAPTURE_BUFFER 64
+#define DEFAULT_STATS 0
 
-// - Helpers -------------------------------------------------------------------
-static bool prev_shift_tab = false;
+static_assert(STATS_CLASSES == CLASS_COUNT, "stats block class count");
+
+// Default instance driven by the RPI entry points, published by the init thread
+static std::atomic<engine_t *> s_engine(NULL);
+static std::atomic<int> s_init_started(0);
+static int pipeline = DEFAULT_PIPELINE;
+static int capture_scale = DEFAULT_CAPTURE_SCALE;
+static int capture_buffer = DEFAULT_CAPTURE_BUFFER;
+static char capture_dir[MAX_PATH] = {0};
 
-static inline bool key_down(int vk) {
-    return (GetAsyncKeyState(vk) & 0x8000) != 0;
+// - Helpers -------------------------------------------------------------------
+// Cycle the classification debug view: off -> overlay -> map
+static void cycle_debug_view(engine_t *engine) {
+    static const char *names[DEBUG_VIEW_COUNT] = {"off", "overlay", "map"};
+    const int view = (engine_debug_view(engine) + 1) % DEBUG_VIEW_COUNT;
+    engine_set_debug_view(engine, view);
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Debug view: %s", names[view]);
+    notification_message(engine_overlay(engine), msg);
 }
 
-// Returns true only on the transition "not pressed" -> "pressed" for Shift+Tab.
-bool shift_tab_pressed_once() {
-    bool now = (key_down(VK_TAB) && (key_down(VK_LSHIFT) /* || key_down(VK_RSHIFT) */));
+// Start/stop recording of the blended output (.y4m next to the DLL or in capture_dir)
+static void toggle_capture(engine_t *engine, unsigned w, unsigned h) {
+    char msg[128];
 
-    bool triggered = (!prev_shift_tab && now);
-    prev_shift_tab = now;
-    return triggered;
+    if (capture_active()) {
+        unsigned frames = capture_frames_queued();
+        unsigned dropped = capture_stop();
+        snprintf(msg, sizeof(msg), "Capture stopped: %u frames, %u dropped", frames, dropped);
+    } else {
+        char name[64];
+        char path[MAX_PATH];
+        time_t now = time(NULL);
+        strftime(name, sizeof(name), "gigascreen_%Y%m%d_%H%M%S.y4m", localtime(&now));
+        const bool fits = capture_dir[0] ? cfg_join_path(capture_dir, name, path, sizeof(path))
+                                         : cfg_get_path(name, path, sizeof(path));
+
+        // scale 1 records the blended frame before doubling
+        unsigned scale = capture_scale == 2 ? 2 : 1;
+        if (!fits)
+            snprintf(msg, sizeof(msg), "Capture failed: path too long for %s", name);
+        else if (capture_start(path, w * scale, h * scale, capture_buffer))
+            snprintf(msg, sizeof(msg), "Capture started: %s", name);
+        else
+            snprintf(msg, sizeof(msg), "Capture failed: cannot write %s", name);
+    }
+    notification_message(engine_overlay(engine), msg);
 }
 
-// - Plugin init on DLL attachment ---------------------------------------------
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID reserved) {
-    if (reason == DLL_PROCESS_ATTACH) {
-        // Initialize configuration file
-        cfg_init("gigascreen.cfg");
-
-        // Read the configuration file and update parameters
-        gamma = cfg_get_float("gamma", gamma);
-        ratio = cfg_get_float("ratio", ratio);
-        mode = cfg_get_int("mode", mode);
-        fullbright = cfg_get_int("fullbright", fullbright);
-        motion_check = cfg_get_int("motion_check", motion_check);
-        show_banner = cfg_get_int("show_banner", show_banner);
-
-        // Initialize gamma lookup tables (LUTs) according to configuration
-        lut_blend_5b = lutmgr_init_5b(gamma, ratio);
-        lut_blend_6b = lutmgr_init_6b(gamma, ratio);
+// Apply a hotkey command from the input thread (render thread, between frames)
+static void apply_command(engine_t *engine, int cmd, unsigned w, unsigned h) {
+    const engine_settings_t *settings = engine_settings(engine);
+    switch (cmd) {
+    case INPUT_CMD_CYCLE_MODE:
+        engine_set_mode(engine, (settings->mode + 1) % MODE_COUNT);
+        notification_update(engine_overlay(engine), settings->mode, settings->gamma, settings->ratio,
+                            settings->motion_check);
+        break;
+    case INPUT_CMD_TOGGLE_CAPTURE:
+        toggle_capture(engine, w, h);
+        break;
+    case INPUT_CMD_CYCLE_DEBUG_VIEW:
+        cycle_debug_view(engine);
+        break;
     }
-    return TRUE;
 }
 
-// - Blending functions --------------------------------------------------------
-// Gigascreen blending via LUTs
-static inline unsigned gigascreen_blend(unsigned p0, unsigned p1) {
-    // Extract RGB pixel components for current frame (5-6-5 packed format)
-    unsigned frame0_r = (p0 >> 11) & 0x1F;
-    unsigned frame0_g = (p0 >> 5) & 0x3F;
-    unsigned frame0_b = p0 & 0x1F;
-
-    // Extract RGB pixel components for previous frame (5-6-5 packed format)
-    unsigned frame1_r = (p1 >> 11) & 0x1F;
-    unsigned frame1_g = (p1 >> 5) & 0x3F;
-    unsigned frame1_b = p1 & 0x1F;
-
-    // Look up precomputed blended components in encoded (5/6-bit) space
-    unsigned r = lut_blend_5b[frame1_r][frame0_r] << 11;
-    unsigned g = lut_blend_6b[frame1_g][frame0_g] << 5;
-    unsigned b = lut_blend_5b[frame1_b][frame0_b];
-
-    return r | g | b;
+// Input thread idle work: render posted overlay text off the render thread
+static void compose_overlay(void *ctx) {
+    notification_compose(engine_overlay((engine_t *)ctx));
 }
 
-// 3Color blending in linear light using LUTs
-static inline unsigned tricolor_blend(unsigned p0, unsigned p1, unsigned p2) {
-    //  Fullbright blending 
-    if (fullbright) {
-        return p0 | p1 | p2; // simple mix, no gamma correction, no ratio 
-    }
+// - Deferred init -------------------------------------------------------------
+// Emulators load every plugin in the directory just to list them, so DllMain
+// does no work: config file I/O and table builds run on a background thread
+// started by the first RenderPluginGetInfo. Until the engine is published,
+// frames are passed through unblended.
+
+static void plugin_init(void) {
+    // Initialize configuration file
+    cfg_init("gigascreen.cfg");
+
+    // Read the configuration file and update parameters
+    engine_settings_t settings;
+    engine_load_settings(&settings);
+    pipeline = cfg_get_int("pipeline", pipeline);
+    capture_scale = cfg_get_int("capture_scale", capture_scale);
+    capture_buffer = cfg_get_int("capture_buffer", capture_buffer);
+    strncpy(capture_dir, cfg_get_str("capture_dir", ""), MAX_PATH - 1);
+
+    // Builds the CRT tables; the default LUT set is compiled in (lut_defaults.h)
+    engine_t *engine = engine_create(&settings);
+
+    // Live statistics for gigascreen_stats (shared memory, see stats_manager.cpp)
+    if (engine && cfg_get_int("stats", DEFAULT_STATS) && stats_open())
+        engine_set_class_stats(engine, true);
 
-    // Decode RGB components from 5-6-5 encoded space to linear colorspace (sRGB -> linear)
-    unsigned frame0_r = lut_rev_5b[(p0 >> 11) & 0x1F];
-    unsigned frame0_g = lut_rev_6b[(p0 >> 5) & 0x3F];
-    unsigned frame0_b = lut_rev_5b[p0 & 0x1F];
-
-    unsigned frame1_r = lut_rev_5b[(p1 >> 11) & 0x1F];
-    unsigned frame1_g = lut_rev_6b[(p1 >> 5) & 0x3F];
-    unsigned frame1_b = lut_rev_5b[p1 & 0x1F];
-
-    unsigned frame2_r = lut_rev_5b[(p2 >> 11) & 0x1F];
-    unsigned frame2_g = lut_rev_6b[(p2 >> 5) & 0x3F];
-    unsigned frame2_b = lut_rev_5b[p2 & 0x1F];
-
-    // Encode averaged linear components back to 5-6-5 encoded space (linear -> sRGB)
-    const float ratio_3c = (1.0 - ratio) * 2.0;
-    const float ratio_rev = 1.0 - ratio_3c;
-    unsigned r =
-        lut_fwd_5b[int((frame0_r + frame1_r + frame2_r) / 3 * ratio_3c + frame0_r * ratio_rev)] << 11;
-    unsigned g =
-        lut_fwd_6b[int((frame0_g + frame1_g + frame2_g) / 3 * ratio_3c + frame0_g * ratio_rev)] << 5;
-    unsigned b =
-        lut_fwd_5b[int((frame0_b + frame1_b + frame2_b) / 3 * ratio_3c + frame0_b * ratio_rev)];
-
-    return r | g | b;
+    // Hotkeys and overlay text are handled on the input thread
+    if (engine)
+        input_start(compose_overlay, engine);
+
+    s_engine.store(engine, std::memory_order_release);
+}
+
+static DWORD WINAPI plugin_init_thread(LPVOID param) {
+    plugin_init();
+    FreeLibraryAndExitThread((HMODULE)param, 0);
+    return 0;
+}
+
+static void plugin_init_start(void) {
+    if (s_init_started.exchange(1))
+        return;
+
+    // the thread keeps the DLL loaded until it is done
+    HMODULE self = NULL;
+    if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCSTR)&plugin_init_thread, &self)) {
+        HANDLE thread = CreateThread(NULL, 0, plugin_init_thread, self, 0, NULL);
+        if (thread) {
+            CloseHandle(thread);
+            return;
+        }
+        FreeLibrary(self);
+    }
+    plugin_init(); // no thread: initialize here, still outside the loader lock
 }
 
-// Check if RGB565 pixel has more than one color component
-static inline bool rgb565_has_multi_component(unsigned int c) {
+#ifdef GIGASCREEN_PROFILE
+// Benchmark harness only: drop the engine so the next RenderPluginGetInfo
+// re-reads gigascreen.cfg
+void plugin_reload(void) {
+    pipeline_reset();
+    while (s_init_started && !s_engine.load())
+        Sleep(1);
+    input_shutdown();
+    engine_destroy(s_engine.exchange(NULL));
+    stats_close();
+    s_init_started = 0;
+}
 
-    // Components
-    unsigned r = c & 0b1111100000000000; // Red
-    unsigned g = c & 0b0000011111100000; // Green
-    unsigned b = c & 0b0000000000011111; // Blue
+// Benchmark harness only: the default instance, to report its parameters
+const engine_t *plugin_engine(void) {
+    return s_engine.load();
+}
+#endif
 
-    // More than one non-zero component?
-    return ((r != 0) + (g != 0) + (b != 0)) > 1;
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID reserved) {
+    if (reason == DLL_PROCESS_DETACH) {
+        // the init and input threads hold a DLL reference, so they have finished by now
+        pipeline_shutdown();
+        engine_destroy(s_engine.exchange(NULL));
+        stats_close();
+    }
+    return TRUE;
 }
 
 // - Plugin Info ---------------------------------------------------------------
@@ -178,9 +223,27 @@ extern "C" RENDER_PLUGIN_INFO *RenderPluginGetInfo(void) {
     rpi_strcpy(&MyRPI.Name[0], PLUGIN_TITLE);
     // 16bpp input format (RGB565) + fixed 2x output scale.
     MyRPI.Flags = RPI_VERSION | RPI_565_SUPP | RPI_OUT_SCL2;
+
+    plugin_init_start();
     return &MyRPI;
 }
 
+// 2x pass-through while the engine is not ready
+static void pass_through_2x(const WORD *src, unsigned sp, WORD *dst, unsigned dp, unsigned w, unsigned h) {
+    for (unsigned y = 0; y < h; ++y) {
+        const WORD *srow = src + y * sp;
+        WORD *drow0 = dst + (y * 2) * dp;
+        for (unsigned x = 0; x < w; ++x)
+            drow0[x * 2 + 0] = drow0[x * 2 + 1] = srow[x];
+        std::memcpy(drow0 + dp, drow0, (w * 2) * sizeof(WORD));
+    }
+}
+
+// Pipeline worker entry: blend into the worker's output buffer
+static void render_default(void *ctx, const WORD *src, unsigned sp, WORD *dst, unsigned dp, unsigned w, unsigned h) {
+    engine_render((engine_t *)ctx, src, sp, dst, dp);
+}
+
 // - MAIN Plugin routine -------------------------------------------------------
 extern "C" void RenderPluginOutput(RENDER_PLUGIN_OUTP *rpo) {
     const unsigned w = rpo->SrcW;
@@ -188,15 +251,6 @@ extern "C" void RenderPluginOutput(RENDER_PLUGIN_OUTP *rpo) {
     const unsigned sp = rpo->SrcPitch / 2; // WORDs per source row (16 bpp)
     const unsigned dp = rpo->DstPitch / 2; // WORDs per dest   row (16 bpp)
 
-    // (Re)allocate frame history buffer on size change.
-    if (w != s_w || h != s_h) {
-        frame_size = w * h;
-        frame_history.assign(frame_size * FRAME_HISTORY, 0);
-        s_havePrev = false; // history not initialized yet
-        s_w = w;
-        s_h = h;
-    }
-
     // Ensure destination can hold a 2x image.
     if (!((w * 2) <= rpo->DstW && (h * 2) <= rpo->DstH)) {
         rpo->OutW = rpo->OutH = 0;
@@ -206,112 +260,82 @@ extern "C" void RenderPluginOutput(RENDER_PLUGIN_OUTP *rpo) {
     const WORD *src = (const WORD *)rpo->SrcPtr;
     WORD *dst = (WORD *)rpo->DstPtr;
 
-    if (!s_havePrev) {
+    engine_t *engine = s_engine.load(std::memory_order_acquire);
+    if (!engine) {
+        plugin_init_start(); // in case the host never called RenderPluginGetInfo
+        pass_through_2x(src, sp, dst, dp, w, h);
+        stats_passthrough();
+        rpo->OutW = w * 2;
+        rpo->OutH = h * 2;
+        return;
+    }
+
+    // Wait for a pipelined frame still in flight before touching shared state.
+    pipeline_sync();
+
+    // class counts of the last rendered frame, read while no frame is in flight
+    unsigned class_pixels[CLASS_COUNT];
+    std::memcpy(class_pixels, engine_class_pixels(engine), sizeof(class_pixels));
+
+    // (Re)allocate frame history buffer on size change.
+    if (engine_resize(engine, w, h) && capture_active())
+        toggle_capture(engine, w, h); // recording keeps a fixed frame size
+
+    const engine_settings_t *settings = engine_settings(engine);
+
+    if (!engine_ready(engine)) {
         // First frame: pass-through 2x, also seed the history ring buffer.
-        for (unsigned y = 0; y < h; ++y) {
-            const WORD *srow = src + y * sp;
-            WORD *drow0 = dst + (y * 2) * dp;
-            WORD *drow1 = drow0 + dp;
-
-            for (unsigned x = 0; x < w; ++x) {
-                WORD px = srow[x];
-                drow0[x * 2 + 0] = px;
-                drow0[x * 2 + 1] = px;
-                // Initialize all history slots with the current frame
-                frame_history[y * w + x + frame_size * 0] = px;
-                frame_history[y * w + x + frame_size * 1] = px;
-                frame_history[y * w + x + frame_size * 2] = px;
-                frame_history[y * w + x + frame_size * 3] = px;
-                frame_history[y * w + x + frame_size * 4] = px;
-            }
-            std::memcpy(drow1, drow0, (w * 2) * sizeof(WORD));
-        }
-        s_havePrev = true;
+        engine_seed(engine, src, sp, dst, dp);
+        pipeline_reset();
 
-        // Initialize notification manager
-        notification_init(dp, w, show_banner, PLUGIN_VERSION);
+        // Initialize notification manager; a roi value that was not understood is reported there
+        const char *note = engine_roi_valid(engine) ? NULL : "gigascreen.cfg: invalid roi value ignored";
+        notification_init(engine_overlay(engine), dp, w, settings->show_banner, PLUGIN_VERSION, note);
     } else {
-        if (shift_tab_pressed_once()) {
-            // rotate Mode
-            mode = (mode + 1) % 3;
-            notification_update(mode, gamma, ratio, motion_check);
+        // hotkeys pressed since the last frame
+        int cmds[INPUT_POLL_MAX];
+        const unsigned n = input_poll(cmds);
+        for (unsigned i = 0; i < n; ++i)
+            apply_command(engine, cmds[i], w, h);
+
+        if (pipeline && settings->mode != 0) {
+            // one frame of latency: blend in the background, show the previous result
+            STAGE_BEGIN(STAGE_PRESENT);
+            pipeline_submit(render_default, engine, src, sp, dst, dp, w, h);
+            STAGE_END(STAGE_PRESENT);
+        } else {
+            pipeline_reset();
+            STAGE_BEGIN(STAGE_BLEND);
+            engine_render(engine, src, sp, dst, dp);
+            STAGE_END(STAGE_BLEND);
         }
+    }
 
-        // Compute indices into the frame history ring buffer (most recent first)
-        int idx_p0 = last_frame_idx;                       // N-1 (most recent stored)
-        int idx_p1 = (last_frame_idx + 1) % FRAME_HISTORY; // N-2
-        int idx_p2 = (last_frame_idx + 2) % FRAME_HISTORY; // N-3
-        int idx_p3 = (last_frame_idx + 3) % FRAME_HISTORY; // N-4
-        int idx_p4 = (last_frame_idx + 4) % FRAME_HISTORY; // N-5
-
-        // Advance write position for the next frame to be stored
-        last_frame_idx = (last_frame_idx + FRAME_HISTORY - 1) % FRAME_HISTORY;
-
-        // Blend per-pixel according to the current mode, then 2x replicate.
-        for (unsigned y = 0; y < h; ++y) {
-            const WORD *src_row = src + y * sp;
-            WORD *dst_row0 = dst + (y * 2) * dp;
-            WORD *dst_row1 = dst_row0 + dp;
-            WORD *prev_frame0_row = &frame_history[y * w + frame_size * idx_p0];
-            WORD *prev_frame1_row = &frame_history[y * w + frame_size * idx_p1];
-            WORD *prev_frame2_row = &frame_history[y * w + frame_size * idx_p2];
-            WORD *prev_frame3_row = &frame_history[y * w + frame_size * idx_p3];
-            WORD *prev_frame4_row = &frame_history[y * w + frame_size * idx_p4];
-
-            for (unsigned x = 0; x < w; ++x) {
-
-                WORD p0 = src_row[x];         // pixel at frame N-0 (current)
-                WORD p1 = prev_frame0_row[x]; // pixel at frame N-1
-                WORD p2 = prev_frame1_row[x]; // pixel at frame N-2
-                WORD p3 = prev_frame2_row[x]; // pixel at frame N-3
-                WORD p4 = prev_frame3_row[x]; // pixel at frame N-4
-                WORD p5 = prev_frame4_row[x]; // pixel at frame N-5
-
-                // Mode 0: antiflicker is disabled (fallback option)
-                WORD out = p0;
-                bool multi_components;
-
-                switch (mode) {
-                // Mode 2: antiflicker is enabled (Gigascreen+3Color)
-                case 2:
-                    // skip static pixels
-                    if (p0 == p1 && p0 == p2)
-                        break;
-                    // 3Color simple check
-                    multi_components = rgb565_has_multi_component(p0) ||
-                                       rgb565_has_multi_component(p1) ||
-                                       rgb565_has_multi_component(p2);
-
-                    if (!multi_components && p0 == p3 && p1 == p4 && p2 == p5) {
-                        out = tricolor_blend(p0, p1, p2);
-                    } else {
-                        // fallback to Gigascreen mode
-                        if (!motion_check || (p0 == p2 && p0 != p1 && p1 != p2))
-                            out = gigascreen_blend(p0, p1);
-                    }
-                    break;
-
-                // Mode 1: antiflicker is enabled (Gigascreen only)
-                case 1:
-                    // skip static pixels
-                    if (p0 == p1 && p0 == p2)
-                        break;
-                    if (!motion_check || (p0 == p2 && p0 != p1))
-                        out = gigascreen_blend(p0, p1);
-                    break;
-                }
-
-                dst_row0[x * 2 + 0] = out;
-                dst_row0[x * 2 + 1] = out;
-
-                // store current pixel in the newest history slot
-                prev_frame4_row[x] = p0;
-            }
-            // copy every full row
-            std::memcpy(dst_row1, dst_row0, (w * 2) * sizeof(WORD));
-        }
+    // record the output as shown, without the notification overlay
+    if (capture_active()) {
+        STAGE_BEGIN(STAGE_CAPTURE);
+        capture_frame(dst, dp, capture_scale == 2 ? 1 : 2);
+        STAGE_END(STAGE_CAPTURE);
     }
-    notification_draw(dst);
+
+    STAGE_BEGIN(STAGE_OVERLAY);
+    notification_draw(engine_overlay(engine), dst);
+    STAGE_END(STAGE_OVERLAY);
+
+    // Publish live statistics (no-op unless stats=1)
+    stats_frame_t frame;
+    frame.width = w;
+    frame.height = h;
+    frame.mode = settings->mode;
+    frame.gamma = settings->gamma;
+    frame.ratio = settings->ratio;
+    frame.motion_check = settings->motion_check;
+    frame.pipeline = pipeline;
+    frame.debug_view = engine_debug_view(engine);
+    frame.capturing = capture_active();
+    frame.capture_dropped = capture_frames_dropped();
+    frame.class_pixels = class_pixels;
+    stats_publish(&frame);
 
     // Report actual output size.
     rpo->OutW = w * 2;
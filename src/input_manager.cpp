@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+// Hotkey input for Gigascreen Render Plugin
+//
+// A low-priority thread polls the keyboard at its own cadence and posts one
+// command per hotkey press into a single-producer/single-consumer ring. The
+// render call takes the commands with one acquire load of the ring head, so
+// frames without a key press make no system calls for input. After each poll
+// the thread also runs the overlay composition (notification_compose), which
+// keeps text rendering off the render thread.
+//
+// Like the pipeline worker, the thread holds a reference to the DLL and exits
+// on its own once no frames have been rendered for a while; the next frame
+// starts it again.
+//------------------------------------------------------------------------------
+
+#include "input_manager.h"
+#include "platform.h"
+#include <atomic>
+
+// keyboard poll interval and idle timeout (milliseconds)
+#define INPUT_POLL_INTERVAL 10
+#define INPUT_IDLE_TIMEOUT 1000
+
+// command ring size (power of two)
+#define INPUT_QUEUE_SIZE 16
+
+typedef struct {
+    int cmd;
+    bool ctrl;
+    bool shift;
+} input_hotkey_t;
+
+// Tab chords; a new hotkey is one more row here and a case in the plugin
+static const input_hotkey_t s_hotkeys[] = {
+    {INPUT_CMD_CYCLE_MODE, false, true},
+    {INPUT_CMD_TOGGLE_CAPTURE, true, false},
+    {INPUT_CMD_CYCLE_DEBUG_VIEW, true, true},
+};
+#define INPUT_HOTKEYS (sizeof(s_hotkeys) / sizeof(s_hotkeys[0]))
+
+static unsigned char s_queue[INPUT_QUEUE_SIZE];
+static std::atomic<unsigned> s_head(0); // commands posted (input thread)
+static std::atomic<unsigned> s_tail(0); // commands taken (render thread)
+static bool s_pressed[INPUT_HOTKEYS];   // chord state at the last poll
+
+static input_idle_fn s_idle = NULL;
+static void *s_idle_ctx = NULL;
+
+static std::atomic<bool> s_alive(false);     // input thread running
+static std::atomic<bool> s_stop(false);      // input_shutdown() request
+static std::atomic<bool> s_heartbeat(false); // a frame was rendered since the last poll
+static bool s_no_thread = false;             // thread could not be started: poll from input_poll()
+
+// - Keyboard ------------------------------------------------------------------
+
+static inline bool key_down(int vk) {
+    return (GetAsyncKeyState(vk) & 0x8000) != 0;
+}
+
+// Post a command for every hotkey that went "not pressed" -> "pressed" (post =
+// false only records the state). Presses are dropped if the ring is full, i.e.
+// the render thread is stalled.
+static void poll_keyboard(bool post) {
+    const bool tab = key_down(VK_TAB);
+    const bool ctrl = tab && key_down(VK_CONTROL);
+    const bool shift = tab && key_down(VK_LSHIFT) /* || key_down(VK_RSHIFT) */;
+
+    unsigned head = s_head.load(std::memory_order_relaxed);
+    const unsigned tail = s_tail.load(std::memory_order_acquire);
+    for (unsigned i = 0; i < INPUT_HOTKEYS; ++i) {
+        const bool now = tab && ctrl == s_hotkeys[i].ctrl && shift == s_hotkeys[i].shift;
+        if (post && now && !s_pressed[i] && head - tail < INPUT_QUEUE_SIZE)
+            s_queue[head++ % INPUT_QUEUE_SIZE] = (unsigned char)s_hotkeys[i].cmd;
+        s_pressed[i] = now;
+    }
+    s_head.store(head, std::memory_order_release);
+}
+
+// - Thread --------------------------------------------------------------------
+
+static DWORD WINAPI input_thread(LPVOID param) {
+    HMODULE self = (HMODULE)param;
+
+    // a chord still held when the thread (re)starts is not a new press
+    poll_keyboard(false);
+
+    unsigned idle_ms = 0;
+    while (!s_stop.load(std::memory_order_relaxed) && idle_ms < INPUT_IDLE_TIMEOUT) {
+        Sleep(INPUT_POLL_INTERVAL);
+        poll_keyboard(true);
+        if (s_idle)
+            s_idle(s_idle_ctx);
+        idle_ms = s_heartbeat.exchange(false, std::memory_order_relaxed) ? 0 : idle_ms + INPUT_POLL_INTERVAL;
+    }
+
+    // last access to shared state: a new thread may be started right after this
+    s_alive.store(false, std::memory_order_release);
+    FreeLibraryAndExitThread(self, 0);
+    return 0;
+}
+
+static bool input_thread_start(void) {
+    // the thread keeps the DLL loaded until it exits
+    HMODULE self = NULL;
+    if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCSTR)&input_thread, &self))
+        return false;
+
+    s_alive.store(true, std::memory_order_relaxed);
+    HANDLE thread = CreateThread(NULL, 0, input_thread, self, 0, NULL);
+    if (!thread) {
+        s_alive.store(false, std::memory_order_relaxed);
+        FreeLibrary(self);
+        return false;
+    }
+    SetThreadPriority(thread, THREAD_PRIORITY_BELOW_NORMAL);
+    CloseHandle(thread);
+    return true;
+}
+
+// - Public API ----------------------------------------------------------------
+
+void input_start(input_idle_fn idle, void *ctx) {
+    s_idle = idle;
+    s_idle_ctx = ctx;
+    s_stop.store(false, std::memory_order_relaxed);
+    s_heartbeat.store(true, std::memory_order_relaxed);
+    s_no_thread = !input_thread_start();
+}
+
+unsigned input_poll(int *cmds) {
+    if (s_no_thread) {
+        poll_keyboard(true);
+        if (s_idle)
+            s_idle(s_idle_ctx);
+    } else {
+        s_heartbeat.store(true, std::memory_order_relaxed);
+        if (!s_alive.load(std::memory_order_acquire))
+            s_no_thread = !input_thread_start();
+    }
+
+    const unsigned tail = s_tail.load(std::memory_order_relaxed);
+    const unsigned head = s_head.load(std::memory_order_acquire);
+    unsigned n = 0;
+    for (; tail + n != head && n < INPUT_POLL_MAX; ++n)
+        cmds[n] = s_queue[(tail + n) % INPUT_QUEUE_SIZE];
+    if (n)
+        s_tail.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+void input_shutdown(void) {
+    s_stop.store(true, std::memory_order_relaxed);
+    while (s_alive.load(std::memory_order_acquire))
+        Sleep(1);
+
+    // drop commands nobody will apply
+    s_tail.store(s_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    s_idle = NULL;
+    s_idle_ctx = NULL;
+    s_no_thread = false;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Hotkey commands, posted by the input thread and applied by the render thread
+enum {
+    INPUT_CMD_CYCLE_MODE,       // Shift+Tab
+    INPUT_CMD_TOGGLE_CAPTURE,   // Ctrl+Tab
+    INPUT_CMD_CYCLE_DEBUG_VIEW, // Ctrl+Shift+Tab
+    INPUT_CMD_COUNT
+};
+
+// Commands the render thread takes per input_poll() call
+#define INPUT_POLL_MAX 8
+
+// Background work run on the input thread after every keyboard poll (overlay
+// composition); ctx is passed through unchanged
+typedef void (*input_idle_fn)(void *ctx);
+
+// Start the input thread (plugin init). idle may be NULL.
+void input_start(input_idle_fn idle, void *ctx);
+
+// Take pending commands, up to INPUT_POLL_MAX (render thread, every frame).
+// Restarts the input thread if it went idle; without a thread the keyboard is
+// polled and idle() run right here instead.
+unsigned input_poll(int *cmds);
+
+// Stop the input thread and wait for it (not from DllMain)
+void input_shutdown(void);
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+// Default LUT set (gamma 2.2, ratio 0.5) as a compile-time table
+//
+// Generated by tools/gigascreen_lutgen.cpp - do not edit.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "lut_manager.h"
+
+#define LUT_DEFAULT_GAMMA 2.2f
+#define LUT_DEFAULT_RATIO 0.5f
+
+// clang-format off
+static constexpr lut_set_t lut_default_set = {
+    // blend_5b
+    {
+        {0, 0, 0, 0, 5, 5, 5, 5, 5, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 21, 22, 23},
+        {0, 0, 0, 0, 5, 5, 5, 5, 5, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 21, 22, 23},
+        {0, 0, 0, 0, 5, 5, 5, 5, 5, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 21, 22, 23},
+        {0, 0, 0, 0, 5, 5, 5, 5, 5, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 21, 22, 23},
+        {5, 5, 5, 5, 5, 5, 5, 8, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 14, 15, 16, 16, 17, 18, 19, 20, 20, 20, 21, 22, 23},
+        {5, 5, 5, 5, 5, 5, 5, 8, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 14, 15, 16, 16, 17, 18, 19, 20, 20, 20, 21, 22, 23},
+        {5, 5, 5, 5, 5, 5, 5, 8, 8, 8, 8, 10, 10, 10, 11, 11, 13, 13, 14, 14, 15, 16, 16, 17, 18, 19, 20, 20, 20, 21, 22, 23},
+        {5, 5, 5, 5, 8, 8, 8, 8, 8, 10, 10, 10, 11, 11, 11, 13, 13, 14, 14, 15, 16, 16, 17, 18, 18, 19, 20, 20, 21, 22, 23, 23},
+        {5, 5, 5, 5, 8, 8, 8, 8, 8, 10, 10, 10, 11, 11, 11, 13, 13, 14, 14, 15, 16, 16, 17, 18, 18, 19, 20, 20, 21, 22, 23, 23},
+        {8, 8, 8, 8, 8, 8, 8, 10, 10, 10, 10, 11, 11, 11, 13, 13, 14, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 20, 21, 22, 23, 23},
+        {8, 8, 8, 8, 8, 8, 8, 10, 10, 10, 10, 11, 11, 11, 13, 13, 14, 14, 15, 15, 16, 17, 17, 18, 19, 20, 20, 20, 21, 22, 23, 23},
+        {8, 8, 8, 8, 10, 10, 10, 10, 10, 11, 11, 11, 13, 13, 13, 14, 14, 15, 15, 16, 17, 17, 18, 19, 19, 20, 20, 21, 22, 23, 23, 24},
+        {10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 18, 18, 19, 20, 20, 21, 21, 22, 23, 23, 24},
+        {10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 18, 18, 19, 20, 20, 21, 21, 22, 23, 23, 24},
+        {10, 10, 10, 10, 11, 11, 11, 11, 11, 13, 13, 13, 14, 14, 14, 15, 15, 16, 16, 17, 18, 18, 19, 20, 20, 20, 21, 22, 23, 23, 24, 24},
+        {11, 11, 11, 11, 11, 11, 11, 13, 13, 13, 13, 14, 14, 14, 15, 15, 16, 16, 17, 17, 18, 19, 19, 20, 20, 21, 22, 22, 23, 23, 24, 24},
+        {11, 11, 11, 11, 13, 13, 13, 13, 13, 14, 14, 14, 15, 15, 15, 16, 16, 17, 17, 18, 19, 19, 20, 20, 20, 21, 22, 23, 23, 24, 24, 25},
+        {13, 13, 13, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 16, 16, 17, 17, 18, 18, 19, 20, 20, 20, 21, 22, 23, 23, 23, 24, 24, 25},
+        {13, 13, 13, 13, 14, 14, 14, 14, 14, 15, 15, 15, 16, 16, 16, 17, 17, 18, 18, 19, 20, 20, 20, 21, 21, 22, 23, 23, 24, 24, 25, 26},
+        {14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21, 22, 23, 23, 23, 24, 24, 25, 26},
+        {15, 15, 15, 15, 15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21, 21, 22, 23, 23, 24, 24, 24, 25, 26, 26},
+        {15, 15, 15, 15, 16, 16, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 20, 20, 20, 21, 21, 22, 23, 23, 23, 24, 24, 25, 26, 26, 27},
+        {16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18, 19, 19, 20, 20, 20, 20, 21, 22, 22, 23, 23, 24, 24, 24, 25, 26, 26, 27},
+        {17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 19, 19, 19, 20, 20, 20, 20, 21, 21, 22, 23, 23, 23, 24, 24, 25, 25, 26, 26, 27, 27},
+        {17, 17, 17, 17, 18, 18, 18, 18, 18, 19, 19, 19, 20, 20, 20, 20, 20, 21, 21, 22, 23, 23, 23, 24, 24, 24, 25, 26, 26, 27, 27, 28},
+        {18, 18, 18, 18, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 21, 21, 22, 22, 23, 23, 23, 24, 24, 24, 25, 26, 26, 27, 27, 28, 28},
+        {19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 22, 22, 23, 23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 28, 28, 29},
+        {20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 22, 22, 23, 23, 23, 23, 24, 24, 24, 25, 26, 26, 27, 27, 27, 28, 28, 29},
+        {20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 22, 22, 22, 23, 23, 23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29, 30},
+        {21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 23, 23, 23, 23, 23, 24, 24, 24, 24, 25, 26, 26, 26, 27, 27, 28, 28, 28, 29, 30, 30},
+        {22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 25, 25, 26, 26, 26, 27, 27, 28, 28, 28, 29, 30, 30, 31},
+        {23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 24, 25, 25, 26, 26, 26, 27, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31},
+    },
+    // blend_6b
+    {
+        {0, 0, 0, 0, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45},
+        {0, 0, 0, 0, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45},
+        {0, 0, 0, 0, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45},
+        {0, 0, 0, 0, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45},
+        {7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 32, 32, 33, 34, 34, 35, 36, 37, 38, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46},
+        {7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 32, 32, 33, 34, 34, 35, 36, 37, 38, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46},
+        {7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 32, 32, 33, 34, 34, 35, 36, 37, 38, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46},
+        {10, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 39, 40, 41, 41, 42, 43, 43, 44, 45, 45, 46},
+        {10, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 39, 40, 41, 41, 42, 43, 43, 44, 45, 45, 46},
+        {10, 10, 10, 10, 10, 10, 10, 10, 10, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 18, 18, 18, 19, 19, 19, 21, 21, 21, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 30, 30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 39, 40, 41, 41, 42, 43, 43, 44, 45, 45, 46},
+        {10, 10, 10, 10, 13, 13, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 16, 18, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47},
+        {10, 10, 10, 10, 13, 13, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 16, 18, 18, 18, 18, 19, 19, 19, 21, 21, 23, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 31, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47},
+        {13, 13, 13, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 19, 19, 19, 21, 21, 21, 23, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 31, 31, 32, 32, 33, 34, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 42, 43, 43, 44, 45, 45, 46, 47},
+        {13, 13, 13, 13, 13, 13, 13, 13, 13, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 19, 19, 19, 21, 21, 21, 23, 23, 23, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 31, 31, 32, 32, 33, 34, 34, 35, 36, 37, 37, 38, 39, 39, 40, 41, 42, 42, 43, 43, 44, 45, 45, 46, 47},
+        {13, 13, 13, 13, 16, 16, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 18, 19, 19, 19, 19, 21, 21, 21, 23, 23, 24, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 34, 35, 36, 36, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47},
+        {13, 13, 13, 13, 16, 16, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 18, 19, 19, 19, 19, 21, 21, 21, 23, 23, 24, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 32, 32, 33, 34, 34, 35, 36, 36, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47},
+        {16, 16, 16, 16, 16, 16, 16, 16, 16, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 21, 21, 21, 23, 23, 23, 24, 24, 24, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 32, 32, 33, 33, 34, 35, 35, 36, 37, 38, 38, 39, 39, 40, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47},
+        {16, 16, 16, 16, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 21, 21, 21, 21, 23, 23, 23, 24, 24, 25, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 33, 33, 34, 35, 35, 36, 37, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47, 48},
+        {16, 16, 16, 16, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 21, 21, 21, 21, 23, 23, 23, 24, 24, 25, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 33, 33, 34, 35, 35, 36, 37, 37, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47, 48},
+        {18, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 21, 21, 21, 21, 23, 23, 23, 24, 24, 24, 25, 25, 25, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 33, 33, 34, 34, 35, 36, 36, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47, 48},
+        {18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 21, 21, 21, 21, 21, 23, 23, 23, 23, 24, 24, 24, 25, 25, 27, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32, 33, 34, 34, 35, 36, 36, 37, 38, 38, 39, 39, 40, 41, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47, 48, 49},
+        {19, 19, 19, 19, 19, 19, 19, 19, 19, 21, 21, 21, 21, 21, 21, 23, 23, 23, 23, 24, 24, 24, 25, 25, 25, 27, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32, 33, 34, 34, 35, 35, 36, 37, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 44, 45, 45, 46, 47, 47, 48, 49},
+        {19, 19, 19, 19, 19, 19, 19, 19, 19, 21, 21, 21, 21, 21, 21, 23, 23, 23, 23, 24, 24, 24, 25, 25, 25, 27, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32, 33, 34, 34, 35, 35, 36, 37, 37, 38, 39, 39, 39, 40, 41, 42, 43, 43, 44, 44, 45, 45, 46, 47, 47, 48, 49},
+        {19, 19, 19, 19, 21, 21, 21, 21, 21, 21, 21, 21, 23, 23, 23, 23, 23, 24, 24, 24, 24, 25, 25, 25, 27, 27, 28, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32, 33, 33, 34, 35, 35, 36, 37, 37, 38, 39, 39, 39, 40, 41, 42, 42, 43, 43, 44, 45, 45, 46, 47, 47, 48, 49, 49},
+        {21, 21, 21, 21, 21, 21, 21, 21, 21, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 25, 25, 25, 27, 27, 27, 28, 28, 28, 29, 29, 30, 30, 31, 31, 32, 32, 33, 33, 34, 35, 35, 36, 36, 37, 38, 38, 39, 39, 40, 40, 41, 42, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49},
+        {21, 21, 21, 21, 23, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 24, 25, 25, 25, 25, 27, 27, 27, 28, 28, 29, 29, 29, 30, 30, 31, 31, 32, 32, 33, 33, 34, 34, 35, 36, 36, 37, 38, 38, 39, 39, 39, 40, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47, 48, 49, 49, 50},
+        {23, 23, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 24, 24, 25, 25, 25, 25, 27, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30, 31, 31, 32, 32, 33, 33, 34, 34, 35, 36, 36, 37, 37, 38, 39, 39, 39, 40, 41, 41, 42, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49, 50},
+        {23, 23, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25, 25, 25, 25, 27, 27, 27, 27, 28, 28, 28, 29, 29, 30, 30, 30, 31, 31, 32, 32, 33, 33, 34, 34, 35, 35, 36, 37, 37, 38, 39, 39, 39, 40, 40, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47, 48, 49, 49, 50, 51},
+        {24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25, 25, 25, 25, 25, 27, 27, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30, 30, 31, 31, 32, 32, 33, 33, 34, 34, 35, 35, 36, 37, 37, 38, 38, 39, 39, 39, 40, 41, 42, 42, 43, 43, 44, 45, 45, 46, 46, 47, 47, 48, 49, 49, 50, 51},
+        {24, 24, 24, 24, 25, 25, 25, 25, 25, 25, 25, 25, 27, 27, 27, 27, 27, 28, 28, 28, 28, 29, 29, 29, 30, 30, 31, 31, 31, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 37, 38, 38, 39, 39, 39, 40, 41, 41, 42, 43, 43, 44, 44, 45, 45, 46, 47, 47, 48, 49, 49, 50, 51, 51},
+        {25, 25, 25, 25, 25, 25, 25, 25, 25, 27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 29, 29, 29, 30, 30, 30, 31, 31, 31, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 37, 38, 38, 39, 39, 39, 40, 40, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47, 47, 48, 49, 49, 50, 51, 51},
+        {25, 25, 25, 25, 27, 27, 27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 29, 29, 29, 29, 30, 30, 30, 31, 31, 32, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 37, 37, 38, 39, 39, 39, 40, 40, 41, 42, 42, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49, 50, 51, 51, 52},
+        {27, 27, 27, 27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 30, 30, 30, 31, 31, 31, 32, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 37, 37, 38, 39, 39, 39, 39, 40, 41, 41, 42, 43, 43, 43, 44, 45, 45, 46, 47, 47, 47, 48, 49, 49, 50, 51, 51, 52},
+        {27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 29, 30, 30, 30, 30, 31, 31, 31, 32, 32, 33, 33, 33, 34, 34, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 39, 40, 41, 41, 42, 43, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49, 50, 51, 51, 52, 52},
+        {28, 28, 28, 28, 29, 29, 29, 29, 29, 29, 29, 29, 30, 30, 30, 30, 30, 31, 31, 31, 31, 32, 32, 32, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 39, 40, 40, 41, 42, 42, 43, 43, 43, 44, 45, 45, 46, 46, 47, 47, 48, 49, 49, 50, 51, 51, 52, 52, 53},
+        {29, 29, 29, 29, 29, 29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 31, 31, 31, 31, 32, 32, 32, 33, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 39, 40, 40, 41, 41, 42, 43, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49, 49, 50, 51, 51, 52, 52, 53},
+        {29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 30, 30, 31, 31, 31, 31, 31, 32, 32, 32, 32, 33, 33, 33, 34, 34, 35, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 39, 39, 40, 41, 41, 42, 43, 43, 43, 44, 44, 45, 45, 46, 47, 47, 47, 48, 49, 49, 50, 51, 51, 52, 52, 53, 54},
+        {30, 30, 30, 30, 30, 30, 30, 30, 30, 31, 31, 31, 31, 31, 31, 32, 32, 32, 32, 33, 33, 33, 34, 34, 34, 35, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 39, 39, 40, 41, 41, 42, 42, 43, 43, 43, 44, 45, 45, 45, 46, 47, 47, 48, 49, 49, 49, 50, 51, 51, 52, 52, 53, 54},
+        {31, 31, 31, 31, 31, 31, 31, 31, 31, 32, 32, 32, 32, 32, 32, 33, 33, 33, 33, 34, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 38, 38, 39, 39, 39, 39, 40, 40, 41, 42, 42, 43, 43, 43, 44, 44, 45, 45, 46, 46, 47, 47, 48, 49, 49, 50, 50, 51, 51, 52, 52, 53, 54, 54},
+        {31, 31, 31, 31, 32, 32, 32, 32, 32, 32, 32, 32, 33, 33, 33, 33, 33, 34, 34, 34, 34, 35, 35, 35, 36, 36, 37, 37, 37, 38, 38, 39, 39, 39, 39, 40, 40, 41, 41, 42, 43, 43, 43, 44, 44, 45, 45, 45, 46, 47, 47, 48, 48, 49, 49, 50, 51, 51, 52, 52, 53, 54, 54, 55},
+        {32, 32, 32, 32, 32, 32, 32, 32, 32, 33, 33, 33, 33, 33, 33, 34, 34, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 37, 38, 38, 39, 39, 39, 39, 40, 40, 41, 41, 42, 43, 43, 43, 43, 44, 45, 45, 45, 46, 47, 47, 47, 48, 49, 49, 50, 51, 51, 51, 52, 52, 53, 54, 54, 55},
+        {33, 33, 33, 33, 33, 33, 33, 33, 33, 34, 34, 34, 34, 34, 34, 35, 35, 35, 35, 36, 36, 36, 37, 37, 37, 38, 38, 38, 39, 39, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 43, 44, 44, 45, 45, 45, 46, 47, 47, 47, 48, 49, 49, 50, 51, 51, 51, 52, 52, 53, 54, 54, 55, 55},
+        {33, 33, 33, 33, 34, 34, 34, 34, 34, 34, 34, 34, 35, 35, 35, 35, 35, 36, 36, 36, 36, 37, 37, 37, 38, 38, 39, 39, 39, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 43, 44, 44, 45, 45, 45, 46, 47, 47, 47, 48, 49, 49, 49, 50, 51, 51, 52, 52, 53, 54, 54, 55, 55, 56},
+        {34, 34, 34, 34, 35, 35, 35, 35, 35, 35, 35, 35, 36, 36, 36, 36, 36, 37, 37, 37, 37, 38, 38, 38, 39, 39, 39, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 43, 43, 44, 45, 45, 45, 46, 46, 47, 47, 47, 48, 49, 49, 50, 50, 51, 51, 52, 52, 53, 54, 54, 55, 55, 56, 56},
+        {35, 35, 35, 35, 35, 35, 35, 35, 35, 36, 36, 36, 36, 36, 36, 37, 37, 37, 37, 38, 38, 38, 39, 39, 39, 39, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43, 43, 43, 44, 45, 45, 45, 45, 46, 47, 47, 47, 48, 49, 49, 49, 50, 51, 51, 52, 52, 52, 53, 54, 54, 55, 55, 56, 56},
+        {36, 36, 36, 36, 36, 36, 36, 36, 36, 37, 37, 37, 37, 37, 37, 38, 38, 38, 38, 39, 39, 39, 39, 39, 39, 40, 40, 40, 41, 41, 42, 42, 43, 43, 43, 43, 44, 44, 45, 45, 45, 46, 46, 47, 47, 47, 48, 49, 49, 49, 50, 51, 51, 52, 52, 53, 53, 54, 54, 55, 55, 56, 56, 57},
+        {37, 37, 37, 37, 37, 37, 37, 37, 37, 38, 38, 38, 38, 38, 38, 39, 39, 39, 39, 39, 39, 39, 40, 40, 40, 41, 41, 41, 42, 42, 43, 43, 43, 43, 44, 44, 45, 45, 45, 46, 46, 47, 47, 47, 48, 48, 49, 49, 50, 50, 51, 51, 52, 52, 53, 54, 54, 54, 55, 55, 56, 56, 57, 57},
+        {37, 37, 37, 37, 38, 38, 38, 38, 38, 38, 38, 38, 39, 39, 39, 39, 39, 39, 39, 39, 39, 40, 40, 40, 41, 41, 42, 42, 42, 43, 43, 43, 43, 44, 44, 45, 45, 45, 45, 46, 47, 47, 47, 48, 48, 49, 49, 49, 50, 51, 51, 52, 52, 52, 53, 54, 54, 55, 55, 56, 56, 57, 57, 58},
+        {38, 38, 38, 38, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 40, 40, 40, 40, 41, 41, 41, 42, 42, 43, 43, 43, 43, 43, 44, 44, 45, 45, 45, 45, 46, 46, 47, 47, 47, 48, 49, 49, 49, 50, 50, 51, 51, 52, 52, 52, 53, 54, 54, 55, 55, 56, 56, 57, 57, 58, 59},
+        {39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 39, 40, 40, 40, 40, 40, 41, 41, 41, 41, 42, 42, 42, 43, 43, 43, 43, 43, 44, 44, 45, 45, 45, 45, 46, 46, 47, 47, 47, 48, 48, 49, 49, 49, 50, 51, 51, 51, 52, 52, 53, 53, 54, 54, 55, 55, 56, 56, 57, 57, 58, 59, 59},
+        {39, 39, 39, 39, 40, 40, 40, 40, 40, 40, 40, 40, 41, 41, 41, 41, 41, 42, 42, 42, 42, 43, 43, 43, 43, 43, 44, 44, 44, 45, 45, 45, 45, 46, 46, 47, 47, 47, 47, 48, 49, 49, 49, 50, 50, 51, 51, 51, 52, 52, 53, 54, 54, 54, 55, 55, 56, 56, 57, 57, 58, 59, 59, 60},
+        {40, 40, 40, 40, 40, 40, 40, 40, 40, 41, 41, 41, 41, 41, 41, 42, 42, 42, 42, 43, 43, 43, 43, 43, 43, 44, 44, 44, 45, 45, 45, 45, 46, 46, 47, 47, 47, 47, 48, 49, 49, 49, 49, 50, 51, 51, 51, 52, 52, 52, 53, 54, 54, 55, 55, 56, 56, 56, 57, 57, 58, 59, 59, 60},
+        {41, 41, 41, 41, 41, 41, 41, 41, 41, 42, 42, 42, 42, 42, 42, 43, 43, 43, 43, 43, 43, 43, 44, 44, 44, 45, 45, 45, 45, 45, 46, 46, 47, 47, 47, 47, 48, 48, 49, 49, 49, 50, 50, 51, 51, 51, 52, 52, 53, 53, 54, 54, 55, 55, 56, 56, 56, 57, 57, 58, 59, 59, 60, 60},
+        {42, 42, 42, 42, 42, 42, 42, 42, 42, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 44, 44, 44, 45, 45, 45, 45, 45, 45, 46, 46, 47, 47, 47, 47, 48, 48, 49, 49, 49, 50, 50, 51, 51, 51, 52, 52, 52, 53, 54, 54, 54, 55, 55, 56, 56, 57, 57, 57, 58, 59, 59, 60, 60, 61},
+        {43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 43, 44, 44, 44, 44, 45, 45, 45, 45, 45, 45, 46, 46, 46, 47, 47, 47, 47, 48, 48, 49, 49, 49, 49, 50, 51, 51, 51, 51, 52, 52, 52, 53, 54, 54, 54, 55, 55, 56, 56, 57, 57, 57, 58, 59, 59, 60, 60, 61, 61},
+        {43, 43, 43, 43, 43, 43, 43, 43, 43, 44, 44, 44, 44, 44, 44, 45, 45, 45, 45, 45, 45, 45, 46, 46, 46, 47, 47, 47, 47, 47, 48, 48, 49, 49, 49, 49, 50, 50, 51, 51, 51, 52, 52, 52, 53, 53, 54, 54, 55, 55, 55, 56, 56, 57, 57, 58, 58, 59, 59, 60, 60, 61, 61, 62},
+        {44, 44, 44, 44, 44, 44, 44, 44, 44, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 46, 46, 46, 47, 47, 47, 47, 47, 47, 48, 48, 49, 49, 49, 49, 50, 50, 51, 51, 51, 52, 52, 52, 52, 53, 54, 54, 54, 55, 55, 55, 56, 56, 57, 57, 58, 59, 59, 59, 60, 60, 61, 61, 62, 62},
+        {45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 46, 46, 46, 46, 47, 47, 47, 47, 47, 47, 48, 48, 48, 49, 49, 49, 49, 50, 50, 51, 51, 51, 51, 52, 52, 52, 53, 53, 54, 54, 54, 55, 55, 56, 56, 56, 57, 57, 58, 59, 59, 59, 60, 60, 61, 61, 62, 62, 63},
+        {45, 45, 45, 45, 45, 45, 45, 45, 45, 46, 46, 46, 46, 46, 46, 47, 47, 47, 47, 47, 47, 47, 48, 48, 48, 49, 49, 49, 49, 49, 50, 50, 51, 51, 51, 51, 52, 52, 52, 53, 53, 54, 54, 54, 55, 55, 55, 56, 56, 56, 57, 57, 58, 59, 59, 60, 60, 60, 61, 61, 62, 62, 63, 63},
+    },
+    // fwd_5b
+    {0, 5, 8, 10, 11, 13, 14, 15, 16, 17, 18, 19, 20, 20, 21, 22, 23, 23, 24, 24, 25, 26, 26, 27, 27, 28, 28, 29, 30, 30, 31, 31},
+    // fwd_6b
+    {0, 7, 10, 13, 16, 18, 19, 21, 23, 24, 25, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 39, 40, 41, 42, 43, 43, 44, 45, 45, 46, 47, 47, 48, 49, 49, 50, 51, 51, 52, 52, 53, 54, 54, 55, 55, 56, 56, 57, 57, 58, 59, 59, 60, 60, 61, 61, 62, 62, 63, 63},
+    // rev_5b
+    {0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 3, 4, 5, 5, 6, 7, 8, 9, 10, 11, 13, 14, 15, 17, 18, 20, 22, 23, 25, 27, 29, 31},
+    // rev_6b
+    {0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 5, 5, 6, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 24, 25, 26, 27, 29, 30, 31, 33, 34, 36, 37, 39, 41, 42, 44, 46, 48, 49, 51, 53, 55, 57, 59, 61, 63},
+};
+// clang-format on
@@ -1,51 +1,48 @@
 #include "lut_manager.h"
+#include "lut_defaults.h"
 #include <math.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 
-// 2D-LUTs for mix combinations
-static unsigned char lut_blend_5b[32][32];
-static unsigned char lut_blend_6b[64][64];
+typedef struct {
+    float gamma;
+    float ratio;
+    lut_set_t set;
+} lut_entry_t;
 
-// Linear->sRGB conversion table
-unsigned char lut_fwd_5b[32];
-unsigned char lut_fwd_6b[64];
-
-// sRGB->Linear conversion table
-unsigned char lut_rev_5b[32];
-unsigned char lut_rev_6b[64];
+// Built sets, searched linearly (a process rarely sees more than a few)
+static std::vector<std::unique_ptr<lut_entry_t> > s_sets;
+static std::mutex s_sets_lock;
 
 static inline float clampf(float x, float lo, float hi) {
     return fminf(fmaxf(x, lo), hi);
 }
 
-static void build_lut(unsigned char *lut, int dim, float gamma, float ratio) {
-    gamma = fmaxf(1.0, gamma);         // gamma <= 1 == linear blending
-    ratio = clampf(ratio, 0.5f, 1.0f); // prio for last frame data
+// sRGB transfer functions on normalized [0..1] components
+static inline float srgb_to_linear(float c, float gamma) {
+    return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, gamma);
+}
 
+static inline float linear_to_srgb(float c, float gamma) {
+    return c <= 0.0031308f ? 12.92f * c : 1.055f * powf(c, 1.0f / gamma) - 0.055f;
+}
+
+static void build_lut(unsigned char *lut, unsigned char *dst_fwd, unsigned char *dst_rev, int dim, float gamma,
+                      float ratio) {
     const float irate = 1.0f - ratio;
-    const float igamma = 1.0f / gamma;
     const float maxvalue = (float)(dim - 1);
 
-    unsigned char *dst_fwd, *dst_rev;
-    if (dim == 32) {
-        dst_fwd = lut_fwd_5b;
-        dst_rev = lut_rev_5b;
-    } else { // dim == 64
-        dst_fwd = lut_fwd_6b;
-        dst_rev = lut_rev_6b;
-    }
-
     // generating sRGB colorspace conversion tables
     for (int i = 0; i < dim; i++) {
         const float component = (float)i / maxvalue;
 
         // building Linear->sRGB conversion table
-        float v_fwd = component <= 0.0031308f ? (12.92f * component) * maxvalue
-                                              : (1.055f * powf(component, igamma) - 0.055f) * maxvalue;
+        float v_fwd = linear_to_srgb(component, gamma) * maxvalue;
         dst_fwd[i] = (unsigned char)(clampf(v_fwd, 0.0f, maxvalue) + 0.5f);
 
         // building sRGB->Linear conversion table
-        float v_rev = component <= 0.04045f ? (component / 12.92f) * maxvalue
-                                            : powf((component + 0.055f) / 1.055f, gamma) * maxvalue;
+        float v_rev = srgb_to_linear(component, gamma) * maxvalue;
         dst_rev[i] = (unsigned char)(clampf(v_rev, 0.0f, maxvalue) + 0.5f);
     }
 
@@ -58,12 +55,102 @@ static void build_lut(unsigned char *lut, int dim, float gamma, float ratio) {
     }
 }
 
-lut5_ptr lutmgr_init_5b(float gamma, float ratio) {
-    build_lut(&lut_blend_5b[0][0], 32, gamma, ratio);
-    return (lut5_ptr)lut_blend_5b;
+static inline float clamp_gamma(float gamma) {
+    return fmaxf(1.0, gamma); // gamma <= 1 == linear blending
+}
+
+static inline float clamp_ratio(float ratio) {
+    return clampf(ratio, 0.5f, 1.0f); // prio for last frame data
+}
+
+void lutmgr_build(lut_set_t *set, float gamma, float ratio) {
+    gamma = clamp_gamma(gamma);
+    ratio = clamp_ratio(ratio);
+    build_lut(&set->blend_5b[0][0], set->fwd_5b, set->rev_5b, 32, gamma, ratio);
+    build_lut(&set->blend_6b[0][0], set->fwd_6b, set->rev_6b, 64, gamma, ratio);
+}
+
+const lut_set_t *lutmgr_get(float gamma, float ratio) {
+    gamma = clamp_gamma(gamma);
+    ratio = clamp_ratio(ratio);
+    if (gamma == LUT_DEFAULT_GAMMA && ratio == LUT_DEFAULT_RATIO)
+        return &lut_default_set;
+
+    std::lock_guard<std::mutex> lock(s_sets_lock);
+    for (size_t i = 0; i < s_sets.size(); i++) {
+        if (s_sets[i]->gamma == gamma && s_sets[i]->ratio == ratio)
+            return &s_sets[i]->set;
+    }
+
+    std::unique_ptr<lut_entry_t> entry(new lut_entry_t);
+    entry->gamma = gamma;
+    entry->ratio = ratio;
+    lutmgr_build(&entry->set, gamma, ratio);
+    s_sets.push_back(std::move(entry));
+    return &s_sets.back()->set;
+}
+
+// Scale a single encoded component by a linear-light factor (gamma-correct dimming)
+static void build_crt_channel(unsigned char *lut, int dim, float gamma, float factor) {
+    const float maxvalue = (float)(dim - 1);
+    for (int i = 0; i < dim; i++) {
+        float v = linear_to_srgb(srgb_to_linear((float)i / maxvalue, gamma) * factor, gamma);
+        lut[i] = (unsigned char)(clampf(v * maxvalue, 0.0f, maxvalue) + 0.5f);
+    }
+}
+
+bool lutmgr_init_crt(crt_lut_t *crt, float gamma, float scanlines, int mask, float mask_level) {
+    gamma = fmaxf(1.0, gamma);
+    scanlines = clampf(scanlines, 0.0f, 1.0f);   // light removed on odd output rows
+    mask_level = clampf(mask_level, 0.0f, 1.0f); // light removed by the aperture mask
+
+    if (scanlines == 0.0f && (mask == CRT_MASK_NONE || mask_level == 0.0f))
+        return false;
+
+    const float dim = 1.0f - mask_level;
+    for (int v = 0; v < CRT_VARIANTS; v++) {
+        const bool odd_row = (v & 2) != 0;
+        const bool odd_col = (v & 1) != 0;
+        const float row = odd_row ? 1.0f - scanlines : 1.0f;
+
+        // per-channel mask factors for this output column
+        float mr = 1.0f, mg = 1.0f, mb = 1.0f;
+        switch (mask) {
+        case CRT_MASK_APERTURE: // dark stripe on odd columns
+            if (odd_col)
+                mr = mg = mb = dim;
+            break;
+        case CRT_MASK_STRIPE: // magenta/green phosphor stripes
+            if (odd_col)
+                mr = mb = dim;
+            else
+                mg = dim;
+            break;
+        }
+
+        build_crt_channel(crt->r5[v], 32, gamma, row * mr);
+        build_crt_channel(crt->g6[v], 64, gamma, row * mg);
+        build_crt_channel(crt->b5[v], 32, gamma, row * mb);
+    }
+    return true;
+}
+
+static void build_phosphor_channel(unsigned short *rev, unsigned char *fwd, int dim, float gamma) {
+    const float maxvalue = (float)(dim - 1);
+    const int fwd_size = 1 << PHOSPHOR_FWD_BITS;
+
+    for (int i = 0; i < dim; i++)
+        rev[i] = (unsigned short)(srgb_to_linear((float)i / maxvalue, gamma) * 65535.0f + 0.5f);
+
+    // each entry covers the linear range [i, i + 1) >> PHOSPHOR_FWD_BITS, sampled at its center
+    for (int i = 0; i < fwd_size; i++) {
+        float v = linear_to_srgb((i + 0.5f) / fwd_size, gamma) * maxvalue;
+        fwd[i] = (unsigned char)(clampf(v, 0.0f, maxvalue) + 0.5f);
+    }
 }
 
-lut6_ptr lutmgr_init_6b(float gamma, float ratio) {
-    build_lut(&lut_blend_6b[0][0], 64, gamma, ratio);
-    return (lut6_ptr)lut_blend_6b;
+void lutmgr_init_phosphor(phosphor_lut_t *lut, float gamma) {
+    gamma = clamp_gamma(gamma);
+    build_phosphor_channel(lut->rev_5b, lut->fwd_5b, 32, gamma);
+    build_phosphor_channel(lut->rev_6b, lut->fwd_6b, 64, gamma);
 }
@@ -1,16 +1,55 @@
 #pragma once
 
-// Linear->sRGB conversion table
-extern unsigned char lut_fwd_5b[];
-extern unsigned char lut_fwd_6b[];
+// LUT set for one gamma/ratio combination. Sets are immutable once built and
+// shared read-only by every engine (and tool thread) that uses them.
+typedef struct {
+    // 2D-LUTs for mix combinations
+    unsigned char blend_5b[32][32];
+    unsigned char blend_6b[64][64];
 
-// sRGB->Linear conversion table
-extern unsigned char lut_rev_5b[];
-extern unsigned char lut_rev_6b[];
+    // Linear->sRGB conversion table
+    unsigned char fwd_5b[32];
+    unsigned char fwd_6b[64];
 
-// 2D-LUTs for mix combinations
-typedef unsigned char (*lut5_ptr)[32];
-typedef unsigned char (*lut6_ptr)[64];
+    // sRGB->Linear conversion table
+    unsigned char rev_5b[32];
+    unsigned char rev_6b[64];
+} lut_set_t;
 
-lut5_ptr lutmgr_init_5b(float gamma, float ratio);
-lut6_ptr lutmgr_init_6b(float gamma, float ratio);
+// Returns the shared set for gamma/ratio, building it on first use.
+// Thread-safe; sets live until the process exits. The default gamma/ratio
+// set is a compile-time table (lut_defaults.h) and needs no computation.
+const lut_set_t *lutmgr_get(float gamma, float ratio);
+
+// Build a set from scratch (no caching; used to regenerate lut_defaults.h)
+void lutmgr_build(lut_set_t *set, float gamma, float ratio);
+
+// CRT post-process tables, one variant per 2x2 output position:
+// variant = (odd output row) * 2 + (odd output column)
+#define CRT_VARIANTS 4
+
+#define CRT_MASK_NONE 0
+#define CRT_MASK_APERTURE 1
+#define CRT_MASK_STRIPE 2
+
+typedef struct {
+    unsigned char r5[CRT_VARIANTS][32];
+    unsigned char g6[CRT_VARIANTS][64];
+    unsigned char b5[CRT_VARIANTS][32];
+} crt_lut_t;
+
+// Returns false when the effect is an identity (nothing to apply)
+bool lutmgr_init_crt(crt_lut_t *crt, float gamma, float scanlines, int mask, float mask_level);
+
+// Phosphor mode tables: 16-bit linear light per encoded component, and back
+// to 5/6-bit encoded values from the top PHOSPHOR_FWD_BITS of a linear value
+#define PHOSPHOR_FWD_BITS 12
+
+typedef struct {
+    unsigned short rev_5b[32];
+    unsigned short rev_6b[64];
+    unsigned char fwd_5b[1 << PHOSPHOR_FWD_BITS];
+    unsigned char fwd_6b[1 << PHOSPHOR_FWD_BITS];
+} phosphor_lut_t;
+
+void lutmgr_init_phosphor(phosphor_lut_t *lut, float gamma);
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// Scroll-aware motion detection for Gigascreen Render Plugin
+//
+// motion_check=2: per row, find the horizontal shift that best maps frame N-2
+// (same Gigascreen phase as the current frame) onto the current frame, then
+// the shift of frame N-1 between 0 and that. Rows that scroll are blended with
+// motion-compensated partners; rows that changed without a consistent shift
+// fall back to the per-pixel check of motion_check=1.
+//
+// Candidates are scored by counting equal RGB565 pixels (an exact-match SAD),
+// eight at a time with SSE2. Only the changed run of a row is searched.
+//------------------------------------------------------------------------------
+
+#include "motion_manager.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MOTION_SSE2
+#endif
+
+// 16-bit lane counters are flushed before they could overflow
+#define MOTION_LANE_MAX 32767
+
+unsigned motion_count_matches(const unsigned short *a, const unsigned short *b, unsigned n) {
+    unsigned i = 0;
+    unsigned matches = 0;
+#ifdef MOTION_SSE2
+    const unsigned n8 = n & ~7u;
+    while (i < n8) {
+        const unsigned end = (n8 - i) / 8 > MOTION_LANE_MAX ? i + MOTION_LANE_MAX * 8 : n8;
+        __m128i acc = _mm_setzero_si128();
+        for (; i < end; i += 8) {
+            __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+            acc = _mm_sub_epi16(acc, _mm_cmpeq_epi16(va, vb)); // equal lanes are -1
+        }
+        __m128i sum = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        matches += (unsigned)_mm_cvtsi128_si32(sum);
+    }
+#endif
+    for (; i < n; ++i)
+        matches += a[i] == b[i];
+    return matches;
+}
+
+bool motion_estimate_row(const unsigned short *p0, const unsigned short *p1, const unsigned short *p2, unsigned w,
+                         motion_row_t *motion) {
+    motion->shift1 = motion->shift2 = 0;
+    if (w < MOTION_MAX_SHIFT * 2 + MOTION_MIN_SPAN || std::memcmp(p0, p2, w * sizeof(*p0)) == 0)
+        return false;
+
+    // changed run, trimmed so that x - shift stays inside the row for every candidate
+    unsigned x0 = 0, x1 = w;
+    while (p0[x0] == p2[x0])
+        ++x0;
+    while (p0[x1 - 1] == p2[x1 - 1])
+        --x1;
+    if (x0 < MOTION_MAX_SHIFT)
+        x0 = MOTION_MAX_SHIFT;
+    if (x1 > w - MOTION_MAX_SHIFT)
+        x1 = w - MOTION_MAX_SHIFT;
+    if (x1 < x0 + MOTION_MIN_SPAN)
+        return false;
+    const unsigned n = x1 - x0;
+
+    // frame N-2: nearest shifts first, so ties (flat areas) keep the smaller one
+    unsigned best = motion_count_matches(p0 + x0, p2 + x0, n);
+    int shift2 = 0;
+    for (int d = 1; d <= MOTION_MAX_SHIFT; ++d) {
+        for (int s = d; s >= -d; s -= 2 * d) {
+            unsigned m = motion_count_matches(p0 + x0, p2 + x0 - s, n);
+            if (m > best) {
+                best = m;
+                shift2 = s;
+            }
+        }
+    }
+    // a scroll has to explain nearly all of the changed run
+    if (!shift2 || best < n - n / 8)
+        return false;
+
+    // frame N-1 is the other phase (same shapes, other colours): its shift lies
+    // between 0 and shift2, ties go to the constant-speed guess shift2 / 2
+    const int lo = shift2 < 0 ? shift2 : 0;
+    const int hi = shift2 < 0 ? 0 : shift2;
+    unsigned best1 = 0;
+    int shift1 = 0, dist1 = 0;
+    for (int s = lo; s <= hi; ++s) {
+        unsigned m = motion_count_matches(p0 + x0, p1 + x0 - s, n);
+        int dist = s * 2 - shift2 < 0 ? shift2 - s * 2 : s * 2 - shift2;
+        if (s == lo || m > best1 || (m == best1 && dist < dist1)) {
+            best1 = m;
+            shift1 = s;
+            dist1 = dist;
+        }
+    }
+
+    motion->shift1 = shift1;
+    motion->shift2 = shift2;
+    return true;
+}
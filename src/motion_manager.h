@@ -0,0 +1,24 @@
+#pragma once
+
+// Largest horizontal shift searched between frames N-0 and N-2 (source pixels)
+#define MOTION_MAX_SHIFT 8
+
+// Changed runs shorter than this are not searched (too few pixels to trust)
+#define MOTION_MIN_SPAN 16
+
+// Horizontal scroll of one row: the frame N-1 / N-2 sample of the picture
+// point at x is at x - shift1 / x - shift2
+typedef struct {
+    int shift1;
+    int shift2;
+} motion_row_t;
+
+// Number of positions i < n where a[i] == b[i] (SSE2 with a scalar fallback)
+unsigned motion_count_matches(const unsigned short *a, const unsigned short *b, unsigned n);
+
+// Estimate the scroll of one row from frames N-0 (p0), N-1 (p1) and N-2 (p2).
+// Only the part that differs between p0 and p2 is searched, so static and
+// plain flickering rows cost one compare. Returns false (and zero shifts) when
+// the row is static or no shift explains the change, i.e. real motion.
+bool motion_estimate_row(const unsigned short *p0, const unsigned short *p1, const unsigned short *p2, unsigned w,
+                         motion_row_t *motion);
@@ -1,30 +1,26 @@
 ﻿#include "font.h"
+#include "notifications_manager.h"
+#include "platform.h"
 #include <cstdint>
-#include <windows.h>
 #include <stdio.h>
 
-// 272 = Small border, 320 = Medium, 352 = Large
-#define NOTIFICATION_WIDTH 352*2
-#define NOTIFICATION_HEIGHT 10
 #define NOTIFICATION_OFFSET 0
 // notification delay in frames: divide by 50 to get seconds
 #define NOTIFICATION_DELAY 200
 #define COLOR_SHADOW 0b0000000000000001
 #define COLOR_TEXT 0b1111111111011100
 
-// buffer is double-sized to hide the second line in banner message
-unsigned short notification_bar[NOTIFICATION_WIDTH * NOTIFICATION_HEIGHT * 2];  
-unsigned int notification_delay = 0;
-unsigned int play_banner = 0;
-unsigned int full_width = 0;
-unsigned int view_width = 0;
-bool is_initialized = false;
-int scroll = 0;
+// request kinds
+enum {
+    NOTIFICATION_BANNER,
+    NOTIFICATION_STATUS,
+    NOTIFICATION_MESSAGE
+};
 
 // print a character glyph row by row (1 row = 8 bits)
-void print_char(unsigned char c, int x, int y, WORD color) {
+void print_char(WORD *bar, unsigned char c, int x, int y, WORD color) {
     const unsigned width = NOTIFICATION_WIDTH;
-    WORD *dst = (WORD *)notification_bar + x + y * width;
+    WORD *dst = bar + x + y * width;
 
     unsigned char *char_addr = (unsigned char *)(FONT_BITMAP + (c - 32) * 8);
     for (int i = 0; i < 8; i++) {
@@ -43,22 +39,22 @@ void print_char(unsigned char c, int x, int y, WORD color) {
 }
 
 // print a string character by character
-void print_string(char *str, int cursor_x, int cursor_y) {
+void print_string(WORD *bar, const char *str, int cursor_x, int cursor_y) {
     while (*str) {
         // print character shadow first (with an offset)
-        print_char(*str, cursor_x + 1, cursor_y + 1, COLOR_SHADOW);
-        print_char(*str, cursor_x + 1, cursor_y, COLOR_SHADOW);
+        print_char(bar, *str, cursor_x + 1, cursor_y + 1, COLOR_SHADOW);
+        print_char(bar, *str, cursor_x + 1, cursor_y, COLOR_SHADOW);
         // print actual character over
-        print_char(*str, cursor_x, cursor_y, COLOR_TEXT);
+        print_char(bar, *str, cursor_x, cursor_y, COLOR_TEXT);
         cursor_x += 8;
         str++;
     }
 }
 
 // clear the notification bar before printing
-void notification_bar_clean() {
+void notification_bar_clean(WORD *bar) {
     // clear buffer
-    memset(notification_bar, 0, sizeof(notification_bar));
+    memset(bar, 0, NOTIFICATION_WIDTH * NOTIFICATION_HEIGHT * 2 * sizeof(WORD));
 }
 
 // helper to convert a mode value to a string
@@ -69,7 +65,9 @@ const char *mode_to_string(int value) {
         case 1:
             return "2-frame";
         case 2:
-            return "2- or 3-frame";
+            return "2-, 3- or 4-frame";
+        case 3:
+            return "Phosphor";
         default:
             return "Unknown";
     }
@@ -82,87 +80,172 @@ const char *motion_to_string(int value) {
             return " (fullscreen)";
         case 1:
             return " (adaptive)";
+        case 2:
+            return " (scroll-aware)";
         default:
             return "";
     }
 }
 
-void notification_init(int f_width, int v_width, int show_banner, char* version_str) {
-    full_width = f_width;
-    view_width = v_width;
+// - Render thread -------------------------------------------------------------
+
+// hand new bar contents to the composer; if it has fallen behind, the request
+// is dropped (the composer only renders the latest one anyway)
+static void notification_post(notification_t *n, const notification_request_t &req) {
+    const unsigned head = n->request_head.load(std::memory_order_relaxed);
+    if (head - n->request_tail.load(std::memory_order_acquire) >= NOTIFICATION_REQUESTS)
+        return;
+    n->requests[head % NOTIFICATION_REQUESTS] = req;
+    n->request_head.store(head + 1, std::memory_order_release);
+}
+
+void notification_init(notification_t *n, int f_width, int v_width, int show_banner, const char* version_str,
+                       const char *note) {
+    n->full_width = f_width;
+    n->view_width = v_width;
 
-    if (is_initialized)
+    if (n->is_initialized)
         return;
 
-    is_initialized = true;
-    notification_bar_clean();
+    n->is_initialized = true;
 
     if (show_banner) {
-        play_banner = show_banner;
-        char str[128];
-        int str_len =
-            snprintf(str, sizeof(str), "Gigascreen No-Flick initialized (v%s)", version_str);
-        // center position
-        print_string(str, view_width - str_len * 4, 1);
-
-        str_len = snprintf(str, sizeof(str), "Press Shift+Tab to cycle anti-flicker modes");
-        print_string(str, view_width - str_len * 4, NOTIFICATION_HEIGHT + 1);
-        notification_delay = NOTIFICATION_DELAY;
+        n->play_banner = show_banner;
+        notification_request_t req{};
+        req.kind = NOTIFICATION_BANNER;
+        req.view_width = v_width;
+        snprintf(req.text, sizeof(req.text), "%s", version_str);
+        if (note)
+            snprintf(req.note, sizeof(req.note), "%s", note);
+        notification_post(n, req);
+    } else if (note) {
+        notification_message(n, note);
     }
 }
 
-void notification_update(int mode, float gamma, float ratio, int motion_check) {
+void notification_update(notification_t *n, int mode, float gamma, float ratio, int motion_check) {
     // do not update the notification bar until initialized or while the startup banner is playing
-    if (!is_initialized || play_banner > 0)
+    if (!n->is_initialized || n->play_banner > 0)
         return;
 
-    notification_bar_clean();
+    notification_request_t req{};
+    req.kind = NOTIFICATION_STATUS;
+    req.view_width = n->view_width;
+    req.mode = mode;
+    req.gamma = gamma;
+    req.ratio = ratio;
+    req.motion_check = motion_check;
+    notification_post(n, req);
+}
+
+// show a free-form status message (capture, debug views, etc.)
+void notification_message(notification_t *n, const char *str) {
+    if (!n->is_initialized || n->play_banner > 0)
+        return;
 
-    // if the notification is already visible, just extend the delay
-    notification_delay = notification_delay > NOTIFICATION_HEIGHT
-                             ? NOTIFICATION_DELAY - NOTIFICATION_HEIGHT
-                             : NOTIFICATION_DELAY;
+    notification_request_t req{};
+    req.kind = NOTIFICATION_MESSAGE;
+    req.view_width = n->view_width;
+    snprintf(req.text, sizeof(req.text), "%s", str);
+    notification_post(n, req);
+}
 
-    // format the plugin status string
-    char str[128];
-    snprintf(str, sizeof(str), "Anti-flicker: %s%s", 
-             mode_to_string(mode),
-             mode ? motion_to_string(motion_check) : "");
+// - Composer ------------------------------------------------------------------
 
-    print_string(str, 1, 1);
+void notification_compose(notification_t *n) {
+    // the render thread has not picked up the previous bar yet
+    if (n->back_ready.load(std::memory_order_acquire))
+        return;
 
-    snprintf(str, sizeof(str), "| Gamma: %1.1f | Ratio: %d%%", gamma, (int)(ratio * 100));
-    print_string(str, view_width * 2 - 26 * 8, 1);
+    const unsigned tail = n->request_tail.load(std::memory_order_relaxed);
+    const unsigned head = n->request_head.load(std::memory_order_acquire);
+    if (head == tail)
+        return;
+
+    // every request replaces the whole bar, so only the latest one is rendered
+    const notification_request_t req = n->requests[(head - 1) % NOTIFICATION_REQUESTS];
+    n->request_tail.store(head, std::memory_order_release);
+
+    // front only changes while back_ready is set
+    WORD *bar = n->bar[n->front ^ 1];
+    notification_bar_clean(bar);
+
+    char str[128];
+    int str_len;
+    switch (req.kind) {
+        case NOTIFICATION_BANNER:
+            str_len = snprintf(str, sizeof(str), "Gigascreen No-Flick initialized (v%s)", req.text);
+            // center position
+            print_string(bar, str, req.view_width - str_len * 4, 1);
+
+            // a configuration warning takes the place of the hotkey hint
+            str_len = snprintf(str, sizeof(str), "%s",
+                               req.note[0] ? req.note : "Press Shift+Tab to cycle anti-flicker modes");
+            print_string(bar, str, req.view_width - str_len * 4, NOTIFICATION_HEIGHT + 1);
+            break;
+        case NOTIFICATION_STATUS:
+            // format the plugin status string
+            snprintf(str, sizeof(str), "Anti-flicker: %s%s",
+                     mode_to_string(req.mode),
+                     (req.mode == 1 || req.mode == 2) ? motion_to_string(req.motion_check) : "");
+
+            print_string(bar, str, 1, 1);
+
+            snprintf(str, sizeof(str), "| Gamma: %1.1f | Ratio: %d%%", req.gamma, (int)(req.ratio * 100));
+            print_string(bar, str, req.view_width * 2 - 26 * 8, 1);
+            break;
+        default:
+            print_string(bar, req.text, 1, 1);
+            break;
+    }
+
+    n->back_kind = req.kind;
+    n->back_ready.store(true, std::memory_order_release);
 }
 
-void notification_draw(unsigned short *dst) {
+void notification_draw(notification_t *n, unsigned short *dst) {
+
+    if (!n->is_initialized)
+        return;
+
+    // show a newly composed bar
+    if (n->back_ready.load(std::memory_order_acquire)) {
+        n->front ^= 1;
+        if (n->back_kind == NOTIFICATION_BANNER)
+            n->delay = NOTIFICATION_DELAY;
+        else // if the notification is already visible, just extend the delay
+            n->delay = n->delay > NOTIFICATION_HEIGHT
+                       ? NOTIFICATION_DELAY - NOTIFICATION_HEIGHT
+                       : NOTIFICATION_DELAY;
+        n->back_ready.store(false, std::memory_order_release);
+    }
 
-    // do not draw the notification bar until initialized, or if the bar is hidden
-    if (!is_initialized || notification_delay == 0)
+    // do not draw the notification bar if it is hidden
+    if (n->delay == 0)
         return;
 
     // reset the banner animation flag once the bar animation is finished
-    if (--notification_delay == 0) {
-        play_banner = 0;
-        scroll = 0;
+    if (--n->delay == 0) {
+        n->play_banner = 0;
+        n->scroll = 0;
     }
 
     // the notification bar offset is always zero (kept for prototyping other scenarios)
     int start_y = NOTIFICATION_OFFSET;
 
     // y-position animation while sliding down
-    if (notification_delay < NOTIFICATION_HEIGHT + NOTIFICATION_OFFSET)
-        start_y = notification_delay - NOTIFICATION_HEIGHT;
+    if (n->delay < NOTIFICATION_HEIGHT + NOTIFICATION_OFFSET)
+        start_y = n->delay - NOTIFICATION_HEIGHT;
 
     // y-position animation while sliding up
-    if (notification_delay > NOTIFICATION_DELAY - NOTIFICATION_HEIGHT)
-        start_y = NOTIFICATION_DELAY - notification_delay - NOTIFICATION_HEIGHT;
+    if (n->delay > NOTIFICATION_DELAY - NOTIFICATION_HEIGHT)
+        start_y = NOTIFICATION_DELAY - n->delay - NOTIFICATION_HEIGHT;
 
     // animation logic for the startup banner (two-line message)
-    if (play_banner && notification_delay == NOTIFICATION_HEIGHT && scroll < NOTIFICATION_HEIGHT) {
-        notification_delay++;
-        if (++scroll == NOTIFICATION_HEIGHT)
-            notification_delay = NOTIFICATION_DELAY - NOTIFICATION_HEIGHT;
+    if (n->play_banner && n->delay == NOTIFICATION_HEIGHT && n->scroll < NOTIFICATION_HEIGHT) {
+        n->delay++;
+        if (++n->scroll == NOTIFICATION_HEIGHT)
+            n->delay = NOTIFICATION_DELAY - NOTIFICATION_HEIGHT;
     }
 
     for (int y = start_y; y <= NOTIFICATION_HEIGHT + start_y; y++) {
@@ -172,15 +255,15 @@ void notification_draw(unsigned short *dst) {
         for (int x = 0; x < NOTIFICATION_WIDTH; x++) {
             // draw bottom line
             if (y == NOTIFICATION_HEIGHT + start_y) {
-                dst[full_width * y + x + 0] = COLOR_TEXT;
+                dst[n->full_width * y + x + 0] = COLOR_TEXT;
                 continue;
             }
 
-            int pixel_data = notification_bar[NOTIFICATION_WIDTH * (y - start_y + scroll) + x];
+            int pixel_data = n->bar[n->front][NOTIFICATION_WIDTH * (y - start_y + n->scroll) + x];
 
             // simulate transparency
             if (pixel_data == 0) {
-                pixel_data = dst[full_width * y + x];
+                pixel_data = dst[n->full_width * y + x];
                 if ((pixel_data & 0b1000010000010000) == 0) {
                     // case A: bright on dark
                     pixel_data |= 0b0100001000001000;
@@ -192,7 +275,7 @@ void notification_draw(unsigned short *dst) {
                     pixel_data = p1 | p2;
                 }
             }
-            dst[full_width * y + x + 0] = pixel_data;
+            dst[n->full_width * y + x + 0] = pixel_data;
         }
     }
 }
@@ -1,7 +1,54 @@
 ﻿#pragma once
 
-extern unsigned short notification_bar[];
+#include <atomic>
 
-void notification_init(int full_width, int view_width, int show_banner, char *version_str);
-void notification_update(int mode, float gamma, float ratio, int motion_check);
-void notification_draw(unsigned short *dst);
+// 272 = Small border, 320 = Medium, 352 = Large
+#define NOTIFICATION_WIDTH 352*2
+#define NOTIFICATION_HEIGHT 10
+
+// Pending bar contents (render thread -> composer), ring size
+#define NOTIFICATION_REQUESTS 4
+
+// Bar contents to compose: the arguments of the calls below
+typedef struct {
+    int kind;
+    int view_width;
+    int mode;
+    float gamma;
+    float ratio;
+    int motion_check;
+    char text[96]; // message, or the version string of the banner
+    char note[96]; // banner second line in place of the hotkey hint (config warnings)
+} notification_request_t;
+
+// Overlay state (one instance per engine)
+typedef struct {
+    // bar[front] is shown, the other one is composed in the background;
+    // each buffer is double-sized to hide the second line in banner message
+    unsigned short bar[2][NOTIFICATION_WIDTH * NOTIFICATION_HEIGHT * 2];
+    unsigned int front;
+    int back_kind;                // request composed into the back bar
+    std::atomic<bool> back_ready; // back bar composed, not shown yet
+    notification_request_t requests[NOTIFICATION_REQUESTS];
+    std::atomic<unsigned> request_head; // requests posted (render thread)
+    std::atomic<unsigned> request_tail; // requests taken (composer)
+    unsigned int delay;
+    unsigned int play_banner;
+    unsigned int full_width;
+    unsigned int view_width;
+    bool is_initialized;
+    int scroll;
+} notification_t;
+
+// The calls below run on the render thread and only post the new bar
+// contents; notification_compose renders them on another thread (the input
+// thread, see input_manager.h) and notification_draw shows the result.
+// note (may be NULL) reports a configuration problem: on the banner's second
+// line, or as a message when the banner is disabled
+void notification_init(notification_t *n, int full_width, int view_width, int show_banner, const char *version_str,
+                       const char *note);
+void notification_update(notification_t *n, int mode, float gamma, float ratio, int motion_check);
+void notification_message(notification_t *n, const char *str);
+// Render the latest posted contents into the back bar (composer thread)
+void notification_compose(notification_t *n);
+void notification_draw(notification_t *n, unsigned short *dst);
@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// Pipelined (one-frame latency) rendering for Gigascreen Render Plugin
+//
+// When enabled, RenderPluginOutput copies the incoming frame into an input
+// buffer, hands it to a background worker and immediately presents the output
+// completed during the previous call. The blend then runs concurrently with
+// the emulation of the next frame instead of on the emulator's present path.
+//
+// Every frame is still processed in order (the history ring depends on it),
+// so when the worker is slower than the emulator the next call waits for it.
+//
+// The worker holds a reference to the DLL and exits on its own after being
+// idle for a while (FreeLibraryAndExitThread), so the plugin can be unloaded
+// without joining threads under the loader lock.
+//------------------------------------------------------------------------------
+
+#include "pipeline_manager.h"
+#include "platform.h"
+#include <cstring>
+#include <vector>
+
+// worker exits after this many milliseconds without frames
+#define PIPELINE_IDLE_TIMEOUT 1000
+
+typedef struct {
+    pipeline_render_fn render;
+    void *ctx;
+    const WORD *src;
+    WORD *dst;
+    unsigned w;
+    unsigned h;
+} pipeline_job_t;
+
+static std::vector<WORD> s_input;     // copy of the frame being rendered
+static std::vector<WORD> s_output[2]; // 2x outputs, pitch = w * 2
+static unsigned s_back = 0;           // output slot holding the latest completed frame
+static unsigned s_w = 0;
+static unsigned s_h = 0;
+static bool s_ready = false; // s_output[s_back] holds a completed frame
+static bool s_busy = false;  // a job was posted and not yet synced (render thread only)
+
+static SRWLOCK s_lock = SRWLOCK_INIT;
+static HANDLE s_job_event = NULL;  // auto-reset: job posted
+static HANDLE s_done_event = NULL; // manual-reset: job completed
+static bool s_alive = false;       // worker thread running (guarded by s_lock)
+static pipeline_job_t s_job;
+
+// - Worker --------------------------------------------------------------------
+
+static DWORD WINAPI pipeline_worker(LPVOID param) {
+    HMODULE self = (HMODULE)param;
+
+    for (;;) {
+        if (WaitForSingleObject(s_job_event, PIPELINE_IDLE_TIMEOUT) == WAIT_TIMEOUT) {
+            // re-check under the lock so a job posted right now is not lost
+            AcquireSRWLockExclusive(&s_lock);
+            bool quit = WaitForSingleObject(s_job_event, 0) == WAIT_TIMEOUT;
+            if (quit)
+                s_alive = false;
+            ReleaseSRWLockExclusive(&s_lock);
+            if (quit)
+                break;
+        }
+
+        if (!s_job.render) {
+            // pipeline_stop(): last access to shared state
+            AcquireSRWLockExclusive(&s_lock);
+            s_alive = false;
+            ReleaseSRWLockExclusive(&s_lock);
+            break;
+        }
+        s_job.render(s_job.ctx, s_job.src, s_job.w, s_job.dst, s_job.w * 2, s_job.w, s_job.h);
+        SetEvent(s_done_event);
+    }
+
+    FreeLibraryAndExitThread(self, 0);
+    return 0;
+}
+
+// Post a job to the worker, starting it if needed. Returns false if the worker
+// could not be started (the caller renders synchronously instead).
+static bool pipeline_post(const pipeline_job_t &job) {
+    if (!s_job_event) {
+        s_job_event = CreateEventA(NULL, FALSE, FALSE, NULL);
+        s_done_event = CreateEventA(NULL, TRUE, FALSE, NULL);
+        if (!s_job_event || !s_done_event)
+            return false;
+    }
+
+    bool started = true;
+    AcquireSRWLockExclusive(&s_lock);
+    s_job = job;
+    ResetEvent(s_done_event);
+    if (!s_alive) {
+        // the worker keeps the DLL loaded until it exits
+        HMODULE self = NULL;
+        if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCSTR)&pipeline_worker, &self)) {
+            HANDLE thread = CreateThread(NULL, 0, pipeline_worker, self, 0, NULL);
+            if (thread) {
+                CloseHandle(thread);
+                s_alive = true;
+            } else {
+                FreeLibrary(self);
+                started = false;
+            }
+        } else {
+            started = false;
+        }
+    }
+    if (started)
+        SetEvent(s_job_event);
+    ReleaseSRWLockExclusive(&s_lock);
+
+    s_busy = started;
+    return started;
+}
+
+// Copy a 2x frame from the internal buffer to the emulator's destination
+static void pipeline_present(const WORD *out, WORD *dst, unsigned dst_pitch) {
+    const unsigned row = s_w * 2;
+    for (unsigned y = 0; y < s_h * 2; ++y)
+        std::memcpy(dst + y * dst_pitch, out + y * row, row * sizeof(WORD));
+}
+
+// - Public API ----------------------------------------------------------------
+
+void pipeline_sync(void) {
+    if (!s_busy)
+        return;
+    WaitForSingleObject(s_done_event, INFINITE);
+    s_busy = false;
+}
+
+void pipeline_submit(pipeline_render_fn render, void *ctx, const unsigned short *src, unsigned src_pitch,
+                     unsigned short *dst, unsigned dst_pitch, unsigned w, unsigned h) {
+    pipeline_sync();
+
+    if (w != s_w || h != s_h) {
+        s_input.assign(w * h, 0);
+        s_output[0].assign(w * h * 4, 0);
+        s_output[1].assign(w * h * 4, 0);
+        s_w = w;
+        s_h = h;
+        s_ready = false;
+    }
+
+    if (!s_ready) {
+        // nothing completed yet: render this frame synchronously, it is shown twice
+        render(ctx, src, src_pitch, &s_output[s_back][0], w * 2, w, h);
+        pipeline_present(&s_output[s_back][0], dst, dst_pitch);
+        s_ready = true;
+        return;
+    }
+
+    const unsigned done = s_back;
+    s_back ^= 1;
+
+    for (unsigned y = 0; y < h; ++y)
+        std::memcpy(&s_input[y * w], src + y * src_pitch, w * sizeof(WORD));
+
+    pipeline_job_t job = {render, ctx, &s_input[0], &s_output[s_back][0], w, h};
+    if (!pipeline_post(job)) {
+        render(ctx, job.src, w, job.dst, w * 2, w, h);
+        pipeline_present(job.dst, dst, dst_pitch);
+        return;
+    }
+
+    // present the previous frame while the worker blends the new one
+    pipeline_present(&s_output[done][0], dst, dst_pitch);
+}
+
+void pipeline_reset(void) {
+    pipeline_sync();
+    s_ready = false;
+}
+
+void pipeline_stop(void) {
+    pipeline_reset();
+
+    // an empty job tells the worker to exit
+    AcquireSRWLockExclusive(&s_lock);
+    bool alive = s_alive;
+    if (alive) {
+        s_job.render = NULL;
+        SetEvent(s_job_event);
+    }
+    ReleaseSRWLockExclusive(&s_lock);
+
+    while (alive) {
+        Sleep(1);
+        AcquireSRWLockExclusive(&s_lock);
+        alive = s_alive;
+        ReleaseSRWLockExclusive(&s_lock);
+    }
+}
+
+void pipeline_shutdown(void) {
+    // the worker holds a DLL reference, so it is gone by the time we get here
+    if (s_job_event)
+        CloseHandle(s_job_event);
+    if (s_done_event)
+        CloseHandle(s_done_event);
+    s_job_event = s_done_event = NULL;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Frame renderer run by the pipeline worker (same contract as the synchronous path);
+// ctx is passed through unchanged (the engine instance)
+typedef void (*pipeline_render_fn)(void *ctx, const unsigned short *src, unsigned src_pitch, unsigned short *dst,
+                                   unsigned dst_pitch, unsigned w, unsigned h);
+
+// Wait until the background frame (if any) is complete. After this returns the
+// caller may touch the shared blending state.
+void pipeline_sync(void);
+
+// Queue the current frame for background rendering and write the previously
+// completed output into dst (one frame of latency).
+void pipeline_submit(pipeline_render_fn render, void *ctx, const unsigned short *src, unsigned src_pitch,
+                     unsigned short *dst, unsigned dst_pitch, unsigned w, unsigned h);
+
+// Drop any completed-but-not-presented output and fall back to synchronous rendering
+void pipeline_reset(void);
+
+// Stop the worker and wait for it to exit (not from DllMain). Only needed
+// where the DLL reference the worker holds does not keep it alive until
+// detach (gigascreen_bench); the next submit starts a new worker.
+void pipeline_stop(void);
+
+// Release worker events (DLL detach)
+void pipeline_shutdown(void);
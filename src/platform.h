@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+// Platform layer for Gigascreen Render Plugin
+//
+// The plugin is a Win32 DLL (build.cmd defines _WINDOWS). The offline
+// benchmark/replay harness builds the same sources on Linux; for that build
+// this header provides the small subset of the Win32 API the plugin uses
+// (types, threads, events, SRW locks, timers) on top of pthreads.
+// Keyboard polling always reports "not pressed" outside Windows.
+//------------------------------------------------------------------------------
+#pragma once
+
+#ifdef _WINDOWS
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+#else
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+// same definitions as rpi.h
+typedef unsigned long DWORD;
+typedef unsigned short WORD;
+typedef unsigned char BYTE;
+typedef void *HMODULE;
+
+typedef int BOOL;
+typedef void *HANDLE;
+typedef void *LPVOID;
+typedef const char *LPCSTR;
+typedef DWORD (*LPTHREAD_START_ROUTINE)(LPVOID);
+typedef pthread_rwlock_t SRWLOCK;
+typedef union {
+    long long QuadPart;
+} LARGE_INTEGER;
+
+#define TRUE 1
+#define FALSE 0
+#define APIENTRY
+#define WINAPI
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFFul
+#define WAIT_OBJECT_0 0ul
+#define WAIT_TIMEOUT 258ul
+#define SRWLOCK_INIT PTHREAD_RWLOCK_INITIALIZER
+#define THREAD_PRIORITY_BELOW_NORMAL (-1)
+#define THREAD_PRIORITY_LOWEST (-2)
+#define DLL_PROCESS_DETACH 0
+#define DLL_PROCESS_ATTACH 1
+#define GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT 2
+#define GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS 4
+
+#define VK_TAB 0x09
+#define VK_SHIFT 0x10
+#define VK_CONTROL 0x11
+#define VK_LSHIFT 0xA0
+#define VK_RSHIFT 0xA1
+
+#define _snprintf snprintf
+#define _stricmp strcasecmp
+
+// - Keyboard / modules --------------------------------------------------------
+
+static inline short GetAsyncKeyState(int) {
+    return 0;
+}
+
+// There is no DLL: modules resolve to the executable, paths to the working directory
+static inline BOOL GetModuleHandleExA(DWORD, LPCSTR, HMODULE *module) {
+    *module = NULL;
+    return TRUE;
+}
+
+static inline DWORD GetModuleFileNameA(HMODULE, char *, DWORD) {
+    return 0;
+}
+
+static inline BOOL FreeLibrary(HMODULE) {
+    return TRUE;
+}
+
+static inline void FreeLibraryAndExitThread(HMODULE, DWORD) {
+    pthread_exit(NULL);
+}
+
+// - Threads -------------------------------------------------------------------
+
+typedef struct {
+    LPTHREAD_START_ROUTINE start;
+    LPVOID param;
+} platform_thread_t;
+
+static inline void *platform_thread_main(void *arg) {
+    platform_thread_t t = *(platform_thread_t *)arg;
+    delete (platform_thread_t *)arg;
+    t.start(t.param);
+    return NULL;
+}
+
+// Threads are always detached; the returned handle is only a success flag
+static inline HANDLE CreateThread(void *, size_t, LPTHREAD_START_ROUTINE start, LPVOID param, DWORD, DWORD *) {
+    pthread_t thread;
+    platform_thread_t *t = new platform_thread_t;
+    t->start = start;
+    t->param = param;
+    if (pthread_create(&thread, NULL, platform_thread_main, t) != 0) {
+        delete t;
+        return NULL;
+    }
+    pthread_detach(thread);
+    return (HANDLE)1;
+}
+
+static inline BOOL SetThreadPriority(HANDLE, int) {
+    return TRUE;
+}
+
+static inline void Sleep(DWORD ms) {
+    struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+// - Events --------------------------------------------------------------------
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool manual_reset;
+    bool signaled;
+} platform_event_t;
+
+static inline HANDLE CreateEventA(void *, BOOL manual_reset, BOOL initial_state, LPCSTR) {
+    platform_event_t *e = new platform_event_t;
+    pthread_mutex_init(&e->lock, NULL);
+    pthread_cond_init(&e->cond, NULL);
+    e->manual_reset = manual_reset != FALSE;
+    e->signaled = initial_state != FALSE;
+    return e;
+}
+
+static inline BOOL SetEvent(HANDLE h) {
+    platform_event_t *e = (platform_event_t *)h;
+    pthread_mutex_lock(&e->lock);
+    e->signaled = true;
+    pthread_cond_broadcast(&e->cond);
+    pthread_mutex_unlock(&e->lock);
+    return TRUE;
+}
+
+static inline BOOL ResetEvent(HANDLE h) {
+    platform_event_t *e = (platform_event_t *)h;
+    pthread_mutex_lock(&e->lock);
+    e->signaled = false;
+    pthread_mutex_unlock(&e->lock);
+    return TRUE;
+}
+
+static inline DWORD WaitForSingleObject(HANDLE h, DWORD ms) {
+    platform_event_t *e = (platform_event_t *)h;
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    long long ns = deadline.tv_nsec + (long long)(ms % 1000) * 1000000LL;
+    deadline.tv_sec += ms / 1000 + ns / 1000000000LL;
+    deadline.tv_nsec = ns % 1000000000LL;
+
+    pthread_mutex_lock(&e->lock);
+    while (!e->signaled) {
+        if (ms == INFINITE)
+            pthread_cond_wait(&e->cond, &e->lock);
+        else if (pthread_cond_timedwait(&e->cond, &e->lock, &deadline) == ETIMEDOUT)
+            break;
+    }
+    DWORD result = e->signaled ? WAIT_OBJECT_0 : WAIT_TIMEOUT;
+    if (e->signaled && !e->manual_reset)
+        e->signaled = false;
+    pthread_mutex_unlock(&e->lock);
+    return result;
+}
+
+static inline BOOL CloseHandle(HANDLE h) {
+    // thread handles are flags (see CreateThread), everything else is an event
+    if (h && h != (HANDLE)1) {
+        platform_event_t *e = (platform_event_t *)h;
+        pthread_cond_destroy(&e->cond);
+        pthread_mutex_destroy(&e->lock);
+        delete e;
+    }
+    return TRUE;
+}
+
+// - Locks and timers ----------------------------------------------------------
+
+static inline void AcquireSRWLockExclusive(SRWLOCK *lock) {
+    pthread_rwlock_wrlock(lock);
+}
+
+static inline void ReleaseSRWLockExclusive(SRWLOCK *lock) {
+    pthread_rwlock_unlock(lock);
+}
+
+static inline BOOL QueryPerformanceCounter(LARGE_INTEGER *counter) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    counter->QuadPart = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    return TRUE;
+}
+
+static inline BOOL QueryPerformanceFrequency(LARGE_INTEGER *frequency) {
+    frequency->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+#endif
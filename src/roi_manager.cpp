@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+// Region of interest for Gigascreen Render Plugin
+//
+// Restricts blending to the paper area or to user-defined rectangles
+// (gigascreen.cfg: roi=...). The rectangles are flattened into sorted,
+// non-overlapping [x0, x1) spans per row once per frame size, so the render
+// loop only walks a short list per row. Each engine owns its roi_t.
+//------------------------------------------------------------------------------
+
+#include "platform.h"
+#include "roi_manager.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define ROI_MAX_RECTS 16
+#define PAPER_W 256
+#define PAPER_H 192
+
+typedef struct {
+    int x0, y0, x1, y1;
+} roi_rect_t;
+
+// - Helpers -------------------------------------------------------------------
+
+// Parse the spec into rects; *valid is cleared for anything that is not
+// understood (unknown keyword, malformed or empty rectangle, too many of them)
+static int parse_rects(const char *spec, unsigned w, unsigned h, roi_rect_t *rects, bool *valid) {
+    *valid = true;
+    if (!spec || !*spec || _stricmp(spec, "all") == 0)
+        return 0;
+
+    if (_stricmp(spec, "paper") == 0) {
+        int x0 = ((int)w - PAPER_W) / 2;
+        int y0 = ((int)h - PAPER_H) / 2;
+        rects[0].x0 = x0;
+        rects[0].y0 = y0;
+        rects[0].x1 = x0 + PAPER_W;
+        rects[0].y1 = y0 + PAPER_H;
+        return 1;
+    }
+
+    int count = 0;
+    const char *p = spec;
+    while (*p) {
+        int x, y, rw, rh, end = 0;
+        if (sscanf(p, " %d , %d , %d , %d %n", &x, &y, &rw, &rh, &end) == 4 && (p[end] == ';' || !p[end]) &&
+            rw > 0 && rh > 0 && count < ROI_MAX_RECTS) {
+            rects[count].x0 = x;
+            rects[count].y0 = y;
+            rects[count].x1 = x + rw;
+            rects[count].y1 = y + rh;
+            ++count;
+        } else {
+            *valid = false;
+        }
+        p = strchr(p, ';');
+        if (!p)
+            break;
+        ++p;
+    }
+    return count;
+}
+
+// - Public API ----------------------------------------------------------------
+
+bool roi_init(roi_t *roi, const char *spec, unsigned w, unsigned h) {
+    roi_rect_t rects[ROI_MAX_RECTS];
+    bool valid;
+    int count = parse_rects(spec, w, h, rects, &valid);
+
+    std::vector<unsigned short> &spans = roi->spans;
+    std::vector<unsigned> &rows = roi->rows;
+    spans.clear();
+    rows.assign(h + 1, 0);
+    roi->full = (count == 0);
+
+    std::vector<std::pair<int, int> > row;
+    for (unsigned y = 0; y < h; ++y) {
+        rows[y] = (unsigned)spans.size() / 2;
+
+        row.clear();
+        if (roi->full) {
+            row.push_back(std::make_pair(0, (int)w));
+        } else {
+            for (int i = 0; i < count; ++i) {
+                if ((int)y < rects[i].y0 || (int)y >= rects[i].y1)
+                    continue;
+                int x0 = std::max(rects[i].x0, 0);
+                int x1 = std::min(rects[i].x1, (int)w);
+                if (x0 < x1)
+                    row.push_back(std::make_pair(x0, x1));
+            }
+            std::sort(row.begin(), row.end());
+        }
+
+        // merge overlapping or touching spans
+        for (size_t i = 0; i < row.size(); ++i) {
+            size_t n = spans.size();
+            if (n && (int)spans[n - 1] >= row[i].first && rows[y] * 2 < n) {
+                spans[n - 1] = (unsigned short)std::max((int)spans[n - 1], row[i].second);
+            } else {
+                spans.push_back((unsigned short)row[i].first);
+                spans.push_back((unsigned short)row[i].second);
+            }
+        }
+    }
+    rows[h] = (unsigned)spans.size() / 2;
+    return valid;
+}
+
+unsigned roi_row_spans(const roi_t *roi, unsigned y, const unsigned short **spans) {
+    *spans = roi->spans.empty() ? NULL : &roi->spans[roi->rows[y] * 2];
+    return roi->rows[y + 1] - roi->rows[y];
+}
+
+bool roi_is_full(const roi_t *roi) {
+    return roi->full;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+// Per-row processing spans of one frame size (one instance per engine)
+typedef struct {
+    std::vector<unsigned short> spans; // [x0, x1) pairs, row after row
+    std::vector<unsigned> rows;        // first pair of each row, h + 1 entries
+    bool full;
+} roi_t;
+
+// Build per-row processing spans for a w x h frame from the "roi" config value:
+//   all                 - whole frame (default)
+//   paper               - the 256x192 paper area, centered in the frame
+//   x,y,w,h[;x,y,w,h]   - user-defined rectangles in source pixels
+// Pixels outside the spans are passed through without blending. Returns false
+// if part of the spec was not understood: the valid rectangles are used, or
+// the whole frame if none is left.
+bool roi_init(roi_t *roi, const char *spec, unsigned w, unsigned h);
+
+// Spans of row y as [x0, x1) pairs; returns the number of pairs
+unsigned roi_row_spans(const roi_t *roi, unsigned y, const unsigned short **spans);
+
+// True if every row is processed across the full width
+bool roi_is_full(const roi_t *roi);
@@ -77,7 +77,7 @@ extern	"C"	__declspec(dllexport)	void	RenderPluginOutput(RENDER_PLUGIN_OUTP *rpo
 
 //---------------------------------------------------------------------------------------------------------------------------
 
-static void rpi_strcpy(char *out, char *in)
+static void rpi_strcpy(char *out, const char *in)
 {
 	while(1)
 	{
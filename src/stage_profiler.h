@@ -0,0 +1,31 @@
+//------------------------------------------------------------------------------
+// Per-stage profiling hooks for Gigascreen Render Plugin
+//
+// The render path is split into stages marked with STAGE_BEGIN/STAGE_END.
+// In the plugin build the markers only feed the live statistics block
+// (stats_manager.cpp, a flag check while stats are off); builds that define
+// GIGASCREEN_PROFILE (the benchmark harness) also implement the two profiler
+// hooks, e.g. to read timers and hardware performance counters around every
+// stage.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "stats_manager.h"
+
+enum {
+    STAGE_BLEND,   // history lookups, classification, blending, 2x write
+    STAGE_PRESENT, // pipelined mode: input copy + output present
+    STAGE_CAPTURE, // video capture copy into the ring buffer
+    STAGE_OVERLAY, // notification bar
+    STAGE_COUNT
+};
+
+#ifdef GIGASCREEN_PROFILE
+void profiler_stage_begin(int stage);
+void profiler_stage_end(int stage);
+#define STAGE_BEGIN(stage) (stats_stage_begin(stage), profiler_stage_begin(stage))
+#define STAGE_END(stage) (profiler_stage_end(stage), stats_stage_end(stage))
+#else
+#define STAGE_BEGIN(stage) stats_stage_begin(stage)
+#define STAGE_END(stage) stats_stage_end(stage)
+#endif
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+// Live statistics for Gigascreen Render Plugin
+//
+// With stats=1 the plugin publishes a stats_block_t in a named shared mapping
+// (a pagefile-backed file mapping on Windows, POSIX shm in the Linux harness
+// build) once per frame, for tools/gigascreen_stats to read while the
+// emulator runs.
+//
+// The block is guarded by a seqlock: the render thread bumps the sequence to
+// an odd value, rewrites the block and bumps it again. It never waits for
+// readers; a reader that sees an odd or changed sequence simply copies again.
+// Histograms and counters are kept privately and copied in on publish.
+//
+// A mapping that already exists (a reader left open, or on Linux the segment
+// of an earlier run) is taken over unless the pid in it names another running
+// process, i.e. a second emulator instance that is still publishing.
+//------------------------------------------------------------------------------
+
+#include "stats_manager.h"
+#include "platform.h"
+#include "stage_profiler.h"
+#include <atomic>
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef _WINDOWS
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static_assert(STATS_STAGES == STAGE_COUNT, "stats block stage count");
+
+// Histogram slot of a stage that did not run in a frame
+#define STATS_NO_BIN 0xFF
+
+static stats_block_t *s_block = NULL;
+#ifdef _WINDOWS
+static HANDLE s_mapping = NULL;
+#endif
+
+// Private state, render thread only
+static long long s_qpc_per_us = 0;
+static long long s_stage_begin[STATS_STAGES];
+static long long s_stage_ticks[STATS_STAGES]; // this frame, 0 = not run
+static unsigned char s_ring[STATS_STAGES][STATS_WINDOW];
+static uint32_t s_hist[STATS_STAGES][STATS_HIST_BINS];
+static unsigned s_ring_pos = 0;
+static uint64_t s_frames = 0;
+static uint64_t s_passthrough = 0;
+
+// - Mapping -------------------------------------------------------------------
+
+static uint32_t current_pid(void) {
+#ifdef _WINDOWS
+    return GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+// True if pid is a running process other than this one
+static bool other_process_alive(uint32_t pid) {
+    if (!pid || pid == current_pid())
+        return false;
+#ifdef _WINDOWS
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!process)
+        return false;
+    DWORD code = 0;
+    const bool alive = GetExitCodeProcess(process, &code) && code == STILL_ACTIVE;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
+static stats_block_t *map_block(void) {
+#ifdef _WINDOWS
+    // an existing mapping (ERROR_ALREADY_EXISTS) is opened and reused
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(stats_block_t),
+                                        STATS_MAPPING_NAME);
+    if (!mapping)
+        return NULL;
+    void *view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, sizeof(stats_block_t));
+    if (!view) {
+        CloseHandle(mapping);
+        return NULL;
+    }
+    s_mapping = mapping;
+    return (stats_block_t *)view;
+#else
+    // the segment outlives the process, so a reader keeps the last numbers
+    int fd = shm_open(STATS_MAPPING_NAME, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        return NULL;
+    void *view = MAP_FAILED;
+    if (ftruncate(fd, sizeof(stats_block_t)) == 0)
+        view = mmap(NULL, sizeof(stats_block_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return view == MAP_FAILED ? NULL : (stats_block_t *)view;
+#endif
+}
+
+static void unmap_block(stats_block_t *block) {
+#ifdef _WINDOWS
+    UnmapViewOfFile(block);
+    CloseHandle(s_mapping);
+    s_mapping = NULL;
+#else
+    munmap(block, sizeof(stats_block_t));
+#endif
+}
+
+// Seqlock write section: odd sequence while the block is inconsistent. The
+// release fence keeps the data stores after the odd value; the closing
+// release store publishes them together with the even value.
+static inline uint32_t write_begin(stats_block_t *b) {
+    const uint32_t seq = b->seq.load(std::memory_order_relaxed) | 1u;
+    b->seq.store(seq, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+}
+
+static inline void write_end(stats_block_t *b, uint32_t seq) {
+    b->seq.store(seq + 1, std::memory_order_release);
+}
+
+bool stats_open(void) {
+    if (s_block)
+        return true;
+
+    stats_block_t *block = map_block();
+    if (!block)
+        return false;
+    if (block->magic == STATS_MAGIC && other_process_alive(block->pid)) {
+        // another emulator instance publishes under this name
+        unmap_block(block);
+        return false;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    s_qpc_per_us = frequency.QuadPart / 1000000 ? frequency.QuadPart / 1000000 : 1;
+    memset(s_stage_ticks, 0, sizeof(s_stage_ticks));
+    memset(s_ring, STATS_NO_BIN, sizeof(s_ring));
+    memset(s_hist, 0, sizeof(s_hist));
+    s_ring_pos = 0;
+    s_frames = 0;
+
+    // readers may already hold the mapping, so the header is rewritten under the seqlock too
+    const uint32_t seq = write_begin(block);
+    block->magic = STATS_MAGIC;
+    block->version = STATS_VERSION;
+    block->size = sizeof(stats_block_t);
+    block->pid = current_pid();
+    memset((char *)block + offsetof(stats_block_t, width), 0, sizeof(stats_block_t) - offsetof(stats_block_t, width));
+    write_end(block, seq);
+
+    s_block = block;
+    return true;
+}
+
+void stats_close(void) {
+    if (!s_block)
+        return;
+
+    // no writer any more: the next plugin instance may take the block over
+    const uint32_t seq = write_begin(s_block);
+    s_block->pid = 0;
+    write_end(s_block, seq);
+
+    unmap_block(s_block);
+    s_block = NULL;
+}
+
+// - Render thread hooks -------------------------------------------------------
+
+void stats_stage_begin(int stage) {
+    if (!s_block)
+        return;
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    s_stage_begin[stage] = now.QuadPart;
+}
+
+void stats_stage_end(int stage) {
+    if (!s_block)
+        return;
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    s_stage_ticks[stage] += now.QuadPart - s_stage_begin[stage] + 1; // + 1: ran, even if too fast to measure
+}
+
+void stats_passthrough(void) {
+    ++s_passthrough;
+}
+
+static unsigned us_to_bin(uint32_t us) {
+    unsigned bin = 0;
+    while (us > 1 && bin < STATS_HIST_BINS - 1) {
+        us >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+void stats_publish(const stats_frame_t *frame) {
+    stats_block_t *b = s_block;
+    if (!b)
+        return;
+
+    // roll the histograms: the oldest frame leaves the window, this one enters
+    uint32_t last_us[STATS_STAGES];
+    for (int s = 0; s < STATS_STAGES; ++s) {
+        const unsigned old_bin = s_ring[s][s_ring_pos];
+        if (old_bin != STATS_NO_BIN)
+            s_hist[s][old_bin]--;
+
+        last_us[s] = s_stage_ticks[s] ? (uint32_t)(s_stage_ticks[s] / s_qpc_per_us) : 0;
+        const unsigned bin = s_stage_ticks[s] ? us_to_bin(last_us[s]) : STATS_NO_BIN;
+        s_ring[s][s_ring_pos] = (unsigned char)bin;
+        if (bin != STATS_NO_BIN)
+            s_hist[s][bin]++;
+        s_stage_ticks[s] = 0;
+    }
+    s_ring_pos = (s_ring_pos + 1) % STATS_WINDOW;
+    ++s_frames;
+
+    const uint32_t seq = write_begin(b);
+
+    b->width = frame->width;
+    b->height = frame->height;
+    b->mode = frame->mode;
+    b->gamma = frame->gamma;
+    b->ratio = frame->ratio;
+    b->motion_check = frame->motion_check;
+    b->pipeline = frame->pipeline;
+    b->debug_view = frame->debug_view;
+    b->capturing = frame->capturing;
+    b->frames = s_frames;
+    b->passthrough = s_passthrough;
+    b->capture_dropped = frame->capture_dropped;
+    memcpy(b->stage_last_us, last_us, sizeof(last_us));
+    memcpy(b->stage_hist, s_hist, sizeof(s_hist));
+    if (frame->class_pixels) {
+        for (int c = 0; c < STATS_CLASSES; ++c)
+            b->class_pixels[c] = frame->class_pixels[c];
+    }
+
+    write_end(b, seq);
+}
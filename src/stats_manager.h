@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Live statistics block, published in a named shared mapping for external
+// readers (tools/gigascreen_stats.cpp). Layout changes bump STATS_VERSION.
+#define STATS_MAGIC 0x53544753u // "SGTS"
+#define STATS_VERSION 1
+
+#ifdef _WIN32
+#define STATS_MAPPING_NAME "Local\\gigascreen_stats"
+#else
+#define STATS_MAPPING_NAME "/gigascreen_stats"
+#endif
+
+// Must match STAGE_COUNT (stage_profiler.h) and the pixel classes (blend_engine.h)
+#define STATS_STAGES 4
+#define STATS_CLASSES 8
+
+// Stage time histograms: bin i counts frames that took [2^i, 2^(i+1)) us
+// (bin 0 also takes < 1 us, the last bin everything longer), over the last
+// STATS_WINDOW frames
+#define STATS_HIST_BINS 16
+#define STATS_WINDOW 256
+
+typedef struct {
+    // header, written when the plugin opens the block
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // sizeof(stats_block_t)
+    uint32_t pid; // publishing process, 0 after the plugin closed the block
+
+    // seqlock: odd while the plugin is writing, readers retry on a change
+    std::atomic<uint32_t> seq;
+
+    uint32_t width; // source frame size
+    uint32_t height;
+    int32_t mode;
+    float gamma;
+    float ratio;
+    int32_t motion_check;
+    int32_t pipeline;
+    int32_t debug_view;
+    int32_t capturing;
+
+    uint64_t frames;          // frames rendered (blended or not)
+    uint64_t passthrough;     // frames shown unprocessed while the plugin was still initializing
+    uint64_t capture_dropped; // frames dropped by the current/last recording
+    uint32_t stage_last_us[STATS_STAGES];
+    uint32_t stage_hist[STATS_STAGES][STATS_HIST_BINS];
+    uint32_t class_pixels[STATS_CLASSES]; // pixels per class in the last classified frame
+} stats_block_t;
+
+// Per-frame values supplied by the plugin; the block adds counters and timings
+typedef struct {
+    unsigned width;
+    unsigned height;
+    int mode;
+    float gamma;
+    float ratio;
+    int motion_check;
+    int pipeline;
+    int debug_view;
+    bool capturing;
+    unsigned capture_dropped;
+    const unsigned *class_pixels; // STATS_CLASSES entries, or NULL
+} stats_frame_t;
+
+// Create the shared mapping (plugin init). Returns false if it cannot be
+// created or another plugin instance already publishes under the name.
+bool stats_open(void);
+void stats_close(void);
+
+// Stage timing (STAGE_BEGIN/STAGE_END, render thread only); no-ops while closed
+void stats_stage_begin(int stage);
+void stats_stage_end(int stage);
+
+// Count a frame shown unprocessed because the plugin was still initializing
+void stats_passthrough(void);
+
+// Publish one frame (render thread). Wait-free: the block is written between
+// two sequence increments and readers never hold up the writer.
+void stats_publish(const stats_frame_t *frame);
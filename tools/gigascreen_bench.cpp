@@ -0,0 +1,608 @@
+//------------------------------------------------------------------------------
+// Gigascreen benchmark / replay harness (Linux)
+//
+// Drives the real render plugin sources (src/*.cpp, built against the WinAPI
+// subset in platform.h) with synthetic or recorded frames and reports, per
+// blend mode and per render stage (see stage_profiler.h):
+// - wall time per source pixel
+// - hardware counters via perf_event_open: cycles, instructions,
+//   branch misses, L1D read misses, LLC misses, front-/back-end stalls,
+//   with IPC and per-pixel rates next to the timings
+//
+// Counters are opened per event for the calling thread (user space only), so
+// the tool works with the default perf_event_paranoid=2. With pipeline=1 the
+// blend runs on the plugin's worker thread and is not counted. Counters the CPU or
+// the kernel does not provide (common in VMs) are shown as "-"; multiplexed
+// counters are scaled by their enabled/running time.
+//
+// The plugin reads gigascreen.cfg from the working directory here, so every
+// run writes its own config into a temporary directory first.
+//
+// Synthetic scene (default): a striped border and a paper area split into
+// Gigascreen (2-frame), 3Color, 4-phase flicker and a scrolling pattern.
+// Replay (-i): raw RGB565 little-endian frames of -s WxH, played in a loop.
+//
+// Build: see build_tools.sh.
+//
+// Usage:
+//   gigascreen_bench [options]
+//     -m <list>      comma-separated modes to run (default: 0,1,2)
+//     -n <frames>    measured frames per mode (default: 500)
+//     -w <frames>    warm-up frames per mode (default: 20)
+//     -s <WxH>       frame size (default: 352x296)
+//     -i <file>      replay raw RGB565 frames instead of the synthetic scene
+//     -k <key=value> extra gigascreen.cfg entry (repeatable), e.g. strip_rows=8
+//     -c             also record the output (capture stage)
+//     -j <streams>   also run this many independent engines concurrently, one
+//                    per thread, and report the aggregate throughput
+//     -t             check the blend path chosen for known flicker sequences
+//                    (ABAB, ABC, ABCD, ABAC, AABB, ...) and exit
+//------------------------------------------------------------------------------
+
+#include "../src/blend_engine.h"
+#include "../src/cache_manager.h"
+#include "../src/capture_manager.h"
+#include "../src/input_manager.h"
+#include "../src/pipeline_manager.h"
+#include "../src/platform.h"
+#include "../src/stage_profiler.h"
+#include <algorithm>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <string>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Same layout as RENDER_PLUGIN_OUTP in rpi.h (rpi.h defines MyRPI, so it can
+// only be included by the plugin itself).
+typedef struct {
+    unsigned long Size;
+    unsigned long Flags;
+    void *SrcPtr;
+    unsigned long SrcPitch;
+    unsigned long SrcW;
+    unsigned long SrcH;
+    void *DstPtr;
+    unsigned long DstPitch;
+    unsigned long DstW;
+    unsigned long DstH;
+    unsigned long OutW;
+    unsigned long OutH;
+} bench_outp_t;
+
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID reserved);
+extern "C" void *RenderPluginGetInfo(void);
+extern "C" void RenderPluginOutput(bench_outp_t *rpo);
+// gigascreen_main.cpp, GIGASCREEN_PROFILE builds only
+void plugin_reload(void);
+const engine_t *plugin_engine(void);
+
+// Frames to wait for the plugin's background init before giving up
+#define INIT_WAIT_FRAMES 100000
+
+// Pseudo stage covering the whole RenderPluginOutput call
+#define STAGE_FRAME STAGE_COUNT
+#define STAGE_SLOTS (STAGE_COUNT + 1)
+
+static const char *s_stage_names[STAGE_SLOTS] = {"blend", "present", "capture", "overlay", "frame"};
+
+// - Hardware counters ---------------------------------------------------------
+
+enum {
+    EV_CYCLES,
+    EV_INSTRUCTIONS,
+    EV_BRANCH_MISSES,
+    EV_L1D_MISSES,
+    EV_LLC_MISSES,
+    EV_STALL_FRONTEND,
+    EV_STALL_BACKEND,
+    EV_COUNT
+};
+
+typedef struct {
+    unsigned type;
+    unsigned long long config;
+} event_desc_t;
+
+static const event_desc_t s_events[EV_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+};
+
+typedef struct {
+    unsigned long long value, enabled, running;
+} counter_read_t;
+
+typedef struct {
+    long long ns;
+    double events[EV_COUNT];
+    unsigned long long calls;
+} stage_acc_t;
+
+static int s_fd[EV_COUNT];
+static int s_open_errno = 0; // errno of the first failed open, for the report
+static counter_read_t s_begin[STAGE_SLOTS][EV_COUNT];
+static long long s_begin_ns[STAGE_SLOTS];
+static stage_acc_t s_acc[STAGE_SLOTS];
+static bool s_measure = false;
+static bool s_engine_up = false; // the plugin reached its overlay stage, i.e. has an engine
+
+static void counters_open(void) {
+    for (int i = 0; i < EV_COUNT; ++i) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = s_events[i].type;
+        attr.config = s_events[i].config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        s_fd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (s_fd[i] < 0 && !s_open_errno)
+            s_open_errno = errno;
+    }
+}
+
+static void counters_close(void) {
+    for (int i = 0; i < EV_COUNT; ++i)
+        if (s_fd[i] >= 0)
+            close(s_fd[i]);
+}
+
+static inline long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void counters_read(counter_read_t *out) {
+    for (int i = 0; i < EV_COUNT; ++i) {
+        if (s_fd[i] < 0 || read(s_fd[i], &out[i], sizeof(out[i])) != sizeof(out[i]))
+            out[i].value = out[i].enabled = out[i].running = 0;
+    }
+}
+
+void profiler_stage_begin(int stage) {
+    if (stage == STAGE_OVERLAY)
+        s_engine_up = true;
+    if (!s_measure)
+        return;
+    counters_read(s_begin[stage]);
+    s_begin_ns[stage] = now_ns();
+}
+
+void profiler_stage_end(int stage) {
+    if (!s_measure)
+        return;
+    long long t = now_ns();
+    counter_read_t end[EV_COUNT];
+    counters_read(end);
+
+    stage_acc_t &acc = s_acc[stage];
+    acc.ns += t - s_begin_ns[stage];
+    acc.calls++;
+    for (int i = 0; i < EV_COUNT; ++i) {
+        unsigned long long running = end[i].running - s_begin[stage][i].running;
+        unsigned long long enabled = end[i].enabled - s_begin[stage][i].enabled;
+        double value = (double)(end[i].value - s_begin[stage][i].value);
+        // scale multiplexed counters up to the full interval
+        if (running && running < enabled)
+            value = value * (double)enabled / (double)running;
+        acc.events[i] += value;
+    }
+}
+
+// - Frame sources -------------------------------------------------------------
+
+typedef struct {
+    std::vector<std::string> cfg;
+    std::vector<int> modes;
+    unsigned frames = 500;
+    unsigned warmup = 20;
+    unsigned w = 352;
+    unsigned h = 296;
+    const char *replay = NULL;
+    bool capture = false;
+    unsigned streams = 0;
+    bool check = false;
+} options_t;
+
+static options_t s_opt;
+static std::vector<WORD> s_frames; // all source frames, w * h each
+static unsigned s_frame_count = 0;
+
+#define SYNTH_FRAMES 24 // period 2, 3, 4 and the 8-pixel scroller all repeat
+
+static void synth_scene(void) {
+    const unsigned w = s_opt.w, h = s_opt.h;
+    const unsigned x0 = w > 256 ? (w - 256) / 2 : 0, y0 = h > 192 ? (h - 192) / 2 : 0;
+    static const WORD phase3[3] = {0xF800, 0x07E0, 0x001F};
+    static const WORD phase4[4] = {0xF800, 0x07E0, 0x001F, 0xFFFF};
+
+    s_frame_count = SYNTH_FRAMES;
+    s_frames.assign((size_t)w * h * SYNTH_FRAMES, 0);
+    for (unsigned f = 0; f < SYNTH_FRAMES; ++f) {
+        WORD *frame = &s_frames[(size_t)f * w * h];
+        for (unsigned y = 0; y < h; ++y) {
+            for (unsigned x = 0; x < w; ++x) {
+                WORD v;
+                if (x < x0 || x >= x0 + 256 || y < y0 || y >= y0 + 192)
+                    v = (y & 8) ? 0x001F : 0xF800; // border stripes
+                else if (x < x0 + 96)
+                    v = (f & 1) ? 0xF800 : 0x07E0; // Gigascreen
+                else if (x < x0 + 160)
+                    v = phase3[f % 3]; // 3Color
+                else if (x < x0 + 200)
+                    v = phase4[f % 4]; // 4-phase flicker
+                else
+                    v = ((x + f) & 4) ? 0xFFFF : 0x0000; // scroller
+                frame[y * w + x] = v;
+            }
+        }
+    }
+}
+
+static bool load_replay(void) {
+    FILE *f = fopen(s_opt.replay, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", s_opt.replay);
+        return false;
+    }
+    const size_t frame_bytes = (size_t)s_opt.w * s_opt.h * 2;
+    std::vector<unsigned char> buf(frame_bytes);
+    while (fread(&buf[0], 1, frame_bytes, f) == frame_bytes) {
+        size_t base = s_frames.size();
+        s_frames.resize(base + frame_bytes / 2);
+        for (size_t i = 0; i < frame_bytes / 2; ++i)
+            s_frames[base + i] = (WORD)(buf[i * 2] | (buf[i * 2 + 1] << 8));
+        s_frame_count++;
+    }
+    fclose(f);
+    if (!s_frame_count) {
+        fprintf(stderr, "%s: no complete %ux%u RGB565 frames\n", s_opt.replay, s_opt.w, s_opt.h);
+        return false;
+    }
+    return true;
+}
+
+// - Runs ----------------------------------------------------------------------
+
+static bool write_config(int mode) {
+    FILE *f = fopen("gigascreen.cfg", "wb");
+    if (!f)
+        return false;
+    fprintf(f, "mode=%d\nshow_banner=1\n", mode);
+    for (size_t i = 0; i < s_opt.cfg.size(); ++i)
+        fprintf(f, "%s\n", s_opt.cfg[i].c_str());
+    fclose(f);
+    return true;
+}
+
+static void print_rate(double value, double pixels, bool available) {
+    if (available)
+        printf(" %9.3f", value / pixels);
+    else
+        printf(" %9s", "-");
+}
+
+static void report(int mode, unsigned dropped) {
+    static const char *mode_names[MODE_COUNT] = {"off", "Gigascreen", "2-, 3- or 4-frame", "phosphor"};
+    const double pixels_per_frame = (double)s_opt.w * s_opt.h;
+
+    printf("\nmode %d (%s), %ux%u, %u frames", mode, mode >= 0 && mode < MODE_COUNT ? mode_names[mode] : "?", s_opt.w,
+           s_opt.h, s_opt.frames);
+    if (s_opt.capture)
+        printf(", capture dropped %u", dropped);
+    printf(", strip %u rows (L2 %u KB)", engine_strip_rows(plugin_engine()), cache_l2_size() / 1024);
+    printf("\n%-8s %9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "stage", "ns/px", "cyc/px", "instr/px", "IPC", "brmis/px",
+           "L1Dmis/px", "LLCmis/px", "fe-stall%", "be-stall%");
+
+    for (int s = 0; s < STAGE_SLOTS; ++s) {
+        const stage_acc_t &acc = s_acc[s];
+        if (!acc.calls)
+            continue;
+        // rates are per source pixel of the frames the stage ran on
+        const double pixels = pixels_per_frame * acc.calls;
+        const double cycles = acc.events[EV_CYCLES];
+
+        printf("%-8s %9.3f", s_stage_names[s], acc.ns / pixels);
+        print_rate(cycles, pixels, s_fd[EV_CYCLES] >= 0);
+        print_rate(acc.events[EV_INSTRUCTIONS], pixels, s_fd[EV_INSTRUCTIONS] >= 0);
+        if (s_fd[EV_CYCLES] >= 0 && s_fd[EV_INSTRUCTIONS] >= 0 && cycles > 0)
+            printf(" %9.2f", acc.events[EV_INSTRUCTIONS] / cycles);
+        else
+            printf(" %9s", "-");
+        print_rate(acc.events[EV_BRANCH_MISSES], pixels, s_fd[EV_BRANCH_MISSES] >= 0);
+        print_rate(acc.events[EV_L1D_MISSES], pixels, s_fd[EV_L1D_MISSES] >= 0);
+        print_rate(acc.events[EV_LLC_MISSES], pixels, s_fd[EV_LLC_MISSES] >= 0);
+        for (int e = EV_STALL_FRONTEND; e <= EV_STALL_BACKEND; ++e) {
+            if (s_fd[e] >= 0 && s_fd[EV_CYCLES] >= 0 && cycles > 0)
+                printf(" %9.1f", 100.0 * acc.events[e] / cycles);
+            else
+                printf(" %9s", "-");
+        }
+        printf("\n");
+    }
+    // counters are opened for this thread only
+    if (s_acc[STAGE_PRESENT].calls)
+        printf("pipeline=1: blending runs on the worker thread and is not included above"
+               " (present = frame handoff only)\n");
+}
+
+static bool run_mode(int mode, std::vector<WORD> &dst) {
+    if (!write_config(mode)) {
+        fprintf(stderr, "cannot write gigascreen.cfg\n");
+        return false;
+    }
+    // re-read the config: the plugin initializes in the background and passes
+    // frames through until then, so warm-up only counts once the engine is up
+    plugin_reload();
+    s_engine_up = false;
+    RenderPluginGetInfo();
+
+    memset(s_acc, 0, sizeof(s_acc));
+    static unsigned s_next = 0; // keeps frame order across modes, the history expects it
+    for (unsigned f = 0, ready = 0, measured = 0; measured < s_opt.frames; ++f) {
+        if (!s_engine_up && f >= INIT_WAIT_FRAMES) {
+            fprintf(stderr, "plugin did not initialize\n");
+            return false;
+        }
+        bench_outp_t rpo;
+        memset(&rpo, 0, sizeof(rpo));
+        rpo.Size = sizeof(rpo);
+        rpo.SrcPtr = &s_frames[(size_t)(s_next++ % s_frame_count) * s_opt.w * s_opt.h];
+        rpo.SrcPitch = s_opt.w * 2;
+        rpo.SrcW = s_opt.w;
+        rpo.SrcH = s_opt.h;
+        rpo.DstPtr = &dst[0];
+        rpo.DstPitch = s_opt.w * 4;
+        rpo.DstW = s_opt.w * 2;
+        rpo.DstH = s_opt.h * 2;
+
+        s_measure = s_engine_up && ready >= s_opt.warmup;
+
+        // recording starts once the plugin has seen the frame size (a size change stops it)
+        if (s_opt.capture && s_measure && !measured && !capture_start("bench.y4m", s_opt.w, s_opt.h, 64))
+            fprintf(stderr, "capture: cannot write bench.y4m\n");
+
+        profiler_stage_begin(STAGE_FRAME);
+        RenderPluginOutput(&rpo);
+        profiler_stage_end(STAGE_FRAME);
+        if (s_measure)
+            ++measured;
+        else if (s_engine_up)
+            ++ready;
+    }
+    s_measure = false;
+
+    unsigned dropped = s_opt.capture ? capture_stop() : 0;
+    report(mode, dropped);
+    return true;
+}
+
+// One stream: a private engine blending the whole sequence, output checksum in *hash
+static void stream_main(const engine_settings_t *settings, unsigned long long *hash) {
+    const unsigned w = s_opt.w, h = s_opt.h;
+    std::vector<WORD> dst((size_t)w * h * 4);
+    engine_t *engine = engine_create(settings);
+    if (!engine)
+        return;
+
+    engine_resize(engine, w, h);
+    engine_seed(engine, &s_frames[0], w, &dst[0], w * 2);
+    for (unsigned f = 1; f <= s_opt.frames; ++f)
+        engine_render(engine, &s_frames[(size_t)(f % s_frame_count) * w * h], w, &dst[0], w * 2);
+    engine_destroy(engine);
+
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < dst.size(); ++i)
+        sum = sum * 1000003u + dst[i];
+    *hash = sum;
+}
+
+// Independent engines on all threads at once; same input, so outputs must match
+static void run_streams(void) {
+    engine_settings_t settings;
+    engine_load_settings(&settings); // config of the last run_mode()
+
+    std::vector<unsigned long long> hashes(s_opt.streams, 0);
+    std::vector<std::thread> threads;
+    long long t0 = now_ns();
+    for (unsigned i = 0; i < s_opt.streams; ++i)
+        threads.emplace_back(stream_main, &settings, &hashes[i]);
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    double seconds = (now_ns() - t0) / 1e9;
+
+    bool same = true;
+    for (unsigned i = 1; i < s_opt.streams; ++i)
+        same = same && hashes[i] == hashes[0];
+    double mpx = (double)s_opt.w * s_opt.h * s_opt.frames * s_opt.streams / seconds / 1e6;
+    printf("\n%u streams (mode %d): %.1f Mpx/s total, %.1f Mpx/s per stream, outputs %s\n", s_opt.streams,
+           settings.mode, mpx, mpx / s_opt.streams, same ? "identical" : "DIFFER");
+}
+
+// - Self-check ----------------------------------------------------------------
+// Every case is one colour per frame, repeated with the given period, over a
+// whole (small) frame. After the warm-up, every pixel of every frame of one
+// period must take the expected path (class counters of engine_render).
+
+#define CHECK_W 40 // two uniform chunks plus a per-pixel tail
+#define CHECK_H 4
+#define CHECK_WARMUP 32
+
+typedef struct {
+    const char *name;
+    WORD seq[4];
+    unsigned period;
+    int cls;
+} check_case_t;
+
+static const check_case_t s_checks[] = {
+    {"AAAA", {0xF800}, 1, CLASS_STATIC},
+    {"ABAB", {0xF800, 0x07E0}, 2, CLASS_GIGASCREEN},
+    {"ABC", {0xF800, 0x07E0, 0x001F}, 3, CLASS_TRICOLOR},
+    {"ABCD", {0xF800, 0x07E0, 0x001F, 0xFFFF}, 4, CLASS_QUADCOLOR},
+    {"ABAC", {0xF800, 0x07E0, 0xF800, 0x001F}, 4, CLASS_QUADCOLOR},
+    {"AABB", {0xF800, 0xF800, 0x07E0, 0x07E0}, 4, CLASS_QUADCOLOR},
+};
+
+static const char *s_class_names[CLASS_COUNT] = {"pass",    "static",  "Gigascreen", "scroll",
+                                                 "3Color",  "4-phase", "motion",     "phosphor"};
+
+// Class that took most pixels of the last frame
+static int main_class(const unsigned *pixels) {
+    int best = 0;
+    for (int c = 1; c < CLASS_COUNT; ++c)
+        if (pixels[c] > pixels[best])
+            best = c;
+    return best;
+}
+
+static bool check_case(const check_case_t &c) {
+    engine_settings_t settings;
+    engine_default_settings(&settings);
+    settings.mode = 2;
+    engine_t *engine = engine_create(&settings);
+    if (!engine)
+        return false;
+    engine_set_class_stats(engine, true);
+    engine_resize(engine, CHECK_W, CHECK_H);
+
+    std::vector<WORD> src(CHECK_W * CHECK_H), dst(CHECK_W * CHECK_H * 4);
+    bool ok = true;
+    int got = c.cls;
+    for (unsigned f = 0; f < CHECK_WARMUP + c.period; ++f) {
+        std::fill(src.begin(), src.end(), c.seq[f % c.period]);
+        if (!f) {
+            engine_seed(engine, &src[0], CHECK_W, &dst[0], CHECK_W * 2);
+            continue;
+        }
+        engine_render(engine, &src[0], CHECK_W, &dst[0], CHECK_W * 2);
+        const unsigned *pixels = engine_class_pixels(engine);
+        if (f >= CHECK_WARMUP && pixels[c.cls] != CHECK_W * CHECK_H) {
+            ok = false;
+            got = main_class(pixels);
+        }
+    }
+    engine_destroy(engine);
+
+    printf("%-6s %-10s %s", c.name, s_class_names[c.cls], ok ? "ok" : "FAILED");
+    if (!ok)
+        printf(" (%s)", s_class_names[got]);
+    printf("\n");
+    return ok;
+}
+
+static bool run_checks(void) {
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(s_checks) / sizeof(s_checks[0]); ++i)
+        ok = check_case(s_checks[i]) && ok;
+    return ok;
+}
+
+// - Main ----------------------------------------------------------------------
+
+static void usage(void) {
+    fprintf(stderr, "Usage: gigascreen_bench [-m modes] [-n frames] [-w frames] [-s WxH] [-i file]"
+                    " [-k key=value]... [-c] [-j streams] [-t]\n");
+}
+
+int main(int argc, char **argv) {
+    const char *modes = "0,1,2";
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (a[0] == '-' && a[1] && !a[2] && strchr("mnwsikj", a[1])) {
+            if (++i >= argc) {
+                usage();
+                return 2;
+            }
+            const char *v = argv[i];
+            switch (a[1]) {
+            case 'm': modes = v; break;
+            case 'n': s_opt.frames = (unsigned)atoi(v); break;
+            case 'w': s_opt.warmup = (unsigned)atoi(v); break;
+            case 's':
+                if (sscanf(v, "%ux%u", &s_opt.w, &s_opt.h) != 2 || !s_opt.w || !s_opt.h) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case 'i': s_opt.replay = v; break;
+            case 'k': s_opt.cfg.push_back(v); break;
+            case 'j': s_opt.streams = (unsigned)atoi(v); break;
+            }
+        } else if (strcmp(a, "-c") == 0) {
+            s_opt.capture = true;
+        } else if (strcmp(a, "-t") == 0) {
+            s_opt.check = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    for (const char *p = modes; *p;) {
+        s_opt.modes.push_back(atoi(p));
+        p += strcspn(p, ",");
+        if (*p)
+            ++p;
+    }
+    if (!s_opt.warmup)
+        s_opt.warmup = 1; // the first frame only seeds the history
+    if (s_opt.modes.empty() || !s_opt.frames) {
+        usage();
+        return 2;
+    }
+
+    if (s_opt.check)
+        return run_checks() ? 0 : 1;
+
+    if (!s_opt.replay)
+        synth_scene();
+    else if (!load_replay())
+        return 1;
+
+    // the plugin reads and writes its files in the working directory
+    char workdir[] = "/tmp/gigascreen_bench.XXXXXX";
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd)) || !mkdtemp(workdir) || chdir(workdir) != 0) {
+        fprintf(stderr, "cannot create a working directory\n");
+        return 1;
+    }
+
+    counters_open();
+    if (s_fd[EV_CYCLES] < 0)
+        printf("hardware counters unavailable (%s); check /proc/sys/kernel/perf_event_paranoid\n",
+               strerror(s_open_errno));
+
+    std::vector<WORD> dst((size_t)s_opt.w * s_opt.h * 4);
+    bool ok = true;
+    for (size_t i = 0; i < s_opt.modes.size() && ok; ++i)
+        ok = run_mode(s_opt.modes[i], dst);
+    if (ok && s_opt.streams)
+        run_streams();
+
+    counters_close();
+
+    // Without a loader FreeLibrary is a no-op (platform.h), so the DLL
+    // reference the plugin's threads hold does not keep them alive until
+    // detach: stop them before DllMain frees the engine and the events
+    input_shutdown();
+    pipeline_stop();
+    capture_wait();
+    DllMain(NULL, DLL_PROCESS_DETACH, NULL);
+    remove("gigascreen.cfg");
+    remove("bench.y4m");
+    if (chdir(cwd) != 0 || rmdir(workdir) != 0)
+        fprintf(stderr, "note: %s left behind\n", workdir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,528 @@
+//------------------------------------------------------------------------------
+// Gigascreen batch converter
+//
+// Command-line tool that previews Gigascreen artwork outside an emulator.
+// Decodes ZX Spectrum screen files straight from bitmap + attribute data and
+// blends the two screens with the same gamma/ratio LUTs the render plugin
+// uses (lut_manager.cpp + blend_core.h), then writes PPM or PNG images.
+//
+// Supported inputs:
+// - .scr  6912 bytes, single screen (no blending, plain decode)
+// - .img  13824 bytes, two consecutive 6912-byte screens (Gigascreen)
+// - .mg1/.mg2/.mg4/.mg8  multicolour Gigascreen ("MGH" header, 256 bytes),
+//         followed by bitmap 1, bitmap 2 (6144 bytes each) and the attribute
+//         blocks of both screens (32 attributes per 1/2/4/8 pixel rows)
+//
+// Blending is done at attribute-cell granularity: for every cell the four
+// possible ink/paper combinations of both screens are blended once and then
+// looked up per pixel.
+//
+// Files are spread over a work-stealing thread pool (one deque per worker,
+// idle workers steal from the others), so large archives saturate all cores.
+//
+// Build: see build_tools.cmd (Windows) or build_tools.sh (Linux).
+//
+// Usage:
+//   gigascreen_convert [options] <file|dir>...
+//     -o <dir>       output directory (default: next to the input file)
+//     -f ppm|png     output format (default: png)
+//     -g <gamma>     gamma (default: 2.2)
+//     -r <ratio>     ratio (default: 0.5)
+//     -s <1|2>       output scale (default: 1)
+//     -j <threads>   worker threads (default: all cores)
+//     -q             quiet (errors only)
+//------------------------------------------------------------------------------
+
+#include "../src/blend_core.h"
+#include "../src/lut_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+#define SCREEN_W 256
+#define SCREEN_H 192
+#define BITMAP_SIZE 6144
+#define ATTR_SIZE 768
+#define SCR_SIZE (BITMAP_SIZE + ATTR_SIZE)
+#define MG_HEADER_SIZE 256
+
+// ZX Spectrum palette (normal / bright), 8-bit per component
+#define ZX_NORMAL 0xD7
+#define ZX_BRIGHT 0xFF
+
+typedef struct {
+    std::string out_dir;
+    bool png = true;
+    float gamma = 2.2f;
+    float ratio = 0.5f;
+    unsigned scale = 1;
+    unsigned threads = 0;
+    bool quiet = false;
+} options_t;
+
+typedef struct {
+    const unsigned char *bitmap[2]; // 6144 bytes each, Spectrum screen layout
+    const unsigned char *attr[2];   // 32 attributes per attr_rows pixel rows
+    unsigned attr_rows;             // pixel rows per attribute (1, 2, 4 or 8)
+    unsigned screens;               // 1 = plain screen, 2 = Gigascreen
+} zx_image_t;
+
+static options_t s_opt;
+static blend_params_t s_blend;
+
+// - Decoding ------------------------------------------------------------------
+
+static unsigned short zx_color565(unsigned index, bool bright) {
+    const unsigned v = bright ? ZX_BRIGHT : ZX_NORMAL;
+    const unsigned r = (index & 2) ? v : 0;
+    const unsigned g = (index & 4) ? v : 0;
+    const unsigned b = (index & 1) ? v : 0;
+    return (unsigned short)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+// Offset of pixel row y in the Spectrum bitmap layout
+static inline unsigned zx_row_offset(unsigned y) {
+    return ((y & 0xC0) << 5) | ((y & 0x07) << 8) | ((y & 0x38) << 2);
+}
+
+static bool parse_image(const std::vector<unsigned char> &data, const std::string &ext, zx_image_t &img,
+                        std::string &err) {
+    const unsigned char *p = data.data();
+    const size_t n = data.size();
+
+    if (ext == ".scr") {
+        if (n < SCR_SIZE) {
+            err = "truncated .scr";
+            return false;
+        }
+        img.bitmap[0] = img.bitmap[1] = p;
+        img.attr[0] = img.attr[1] = p + BITMAP_SIZE;
+        img.attr_rows = 8;
+        img.screens = 1;
+        return true;
+    }
+
+    if (ext == ".img") {
+        if (n < SCR_SIZE * 2) {
+            err = "truncated .img";
+            return false;
+        }
+        img.bitmap[0] = p;
+        img.attr[0] = p + BITMAP_SIZE;
+        img.bitmap[1] = p + SCR_SIZE;
+        img.attr[1] = p + SCR_SIZE + BITMAP_SIZE;
+        img.attr_rows = 8;
+        img.screens = 2;
+        return true;
+    }
+
+    if (ext.size() == 4 && ext.compare(0, 3, ".mg") == 0) {
+        if (n < MG_HEADER_SIZE) {
+            err = "truncated multicolour header";
+            return false;
+        }
+        if (std::memcmp(p, "MGH", 3) != 0) {
+            err = "missing MGH header";
+            return false;
+        }
+        const unsigned rows = p[4];
+        if (rows != 1 && rows != 2 && rows != 4 && rows != 8) {
+            err = "unsupported attribute block height";
+            return false;
+        }
+        const size_t attr_size = (SCREEN_H / rows) * 32;
+        if (n < MG_HEADER_SIZE + BITMAP_SIZE * 2 + attr_size * 2) {
+            err = "truncated multicolour image";
+            return false;
+        }
+        img.bitmap[0] = p + MG_HEADER_SIZE;
+        img.bitmap[1] = p + MG_HEADER_SIZE + BITMAP_SIZE;
+        img.attr[0] = p + MG_HEADER_SIZE + BITMAP_SIZE * 2;
+        img.attr[1] = img.attr[0] + attr_size;
+        img.attr_rows = rows;
+        img.screens = 2;
+        return true;
+    }
+
+    err = "unknown format";
+    return false;
+}
+
+// Render an image to RGB565 (256x192), blending per attribute cell
+static void render_image(const zx_image_t &img, std::vector<unsigned short> &out) {
+    out.resize(SCREEN_W * SCREEN_H);
+
+    for (unsigned y = 0; y < SCREEN_H; ++y) {
+        const unsigned char *row0 = img.bitmap[0] + zx_row_offset(y);
+        const unsigned char *row1 = img.bitmap[1] + zx_row_offset(y);
+        const unsigned char *attr0 = img.attr[0] + (y / img.attr_rows) * 32;
+        const unsigned char *attr1 = img.attr[1] + (y / img.attr_rows) * 32;
+        unsigned short *dst = &out[y * SCREEN_W];
+
+        for (unsigned cx = 0; cx < 32; ++cx) {
+            const unsigned a0 = attr0[cx];
+            const unsigned a1 = attr1[cx];
+            const unsigned short ink0 = zx_color565(a0 & 7, (a0 & 0x40) != 0);
+            const unsigned short paper0 = zx_color565((a0 >> 3) & 7, (a0 & 0x40) != 0);
+            const unsigned short ink1 = zx_color565(a1 & 7, (a1 & 0x40) != 0);
+            const unsigned short paper1 = zx_color565((a1 >> 3) & 7, (a1 & 0x40) != 0);
+
+            // cell palette: [bit of screen 1][bit of screen 2]
+            unsigned short cell[2][2];
+            if (img.screens == 1) {
+                cell[0][0] = cell[0][1] = paper0;
+                cell[1][0] = cell[1][1] = ink0;
+            } else {
+                cell[0][0] = (unsigned short)gigascreen_blend(s_blend, paper0, paper1);
+                cell[0][1] = (unsigned short)gigascreen_blend(s_blend, paper0, ink1);
+                cell[1][0] = (unsigned short)gigascreen_blend(s_blend, ink0, paper1);
+                cell[1][1] = (unsigned short)gigascreen_blend(s_blend, ink0, ink1);
+            }
+
+            const unsigned b0 = row0[cx];
+            const unsigned b1 = row1[cx];
+            for (unsigned bit = 0; bit < 8; ++bit) {
+                const unsigned mask = 0x80 >> bit;
+                dst[cx * 8 + bit] = cell[(b0 & mask) != 0][(b1 & mask) != 0];
+            }
+        }
+    }
+}
+
+// - Output --------------------------------------------------------------------
+
+static void to_rgb888(const std::vector<unsigned short> &src, unsigned scale, std::vector<unsigned char> &rgb) {
+    const unsigned w = SCREEN_W * scale;
+    rgb.resize((size_t)w * SCREEN_H * scale * 3);
+    for (unsigned y = 0; y < SCREEN_H * scale; ++y) {
+        for (unsigned x = 0; x < w; ++x) {
+            const unsigned c = src[(y / scale) * SCREEN_W + x / scale];
+            const unsigned r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            unsigned char *d = &rgb[((size_t)y * w + x) * 3];
+            d[0] = (unsigned char)((r << 3) | (r >> 2));
+            d[1] = (unsigned char)((g << 2) | (g >> 4));
+            d[2] = (unsigned char)((b << 3) | (b >> 2));
+        }
+    }
+}
+
+static bool write_ppm(const std::string &path, const std::vector<unsigned char> &rgb, unsigned w, unsigned h) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P6\n%u %u\n255\n", w, h);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    return (fclose(f) == 0) && ok;
+}
+
+static unsigned crc32_update(unsigned crc, const unsigned char *p, size_t n) {
+    static unsigned table[256];
+    static std::once_flag once;
+    std::call_once(once, [] {
+        for (unsigned i = 0; i < 256; ++i) {
+            unsigned c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+    });
+    crc = ~crc;
+    while (n--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void put_be32(std::vector<unsigned char> &v, unsigned x) {
+    v.push_back((unsigned char)(x >> 24));
+    v.push_back((unsigned char)(x >> 16));
+    v.push_back((unsigned char)(x >> 8));
+    v.push_back((unsigned char)x);
+}
+
+static void png_chunk(std::vector<unsigned char> &png, const char *type, const std::vector<unsigned char> &data) {
+    put_be32(png, (unsigned)data.size());
+    const size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    put_be32(png, crc32_update(0, &png[start], png.size() - start));
+}
+
+// PNG with stored (uncompressed) deflate blocks: no zlib dependency
+static bool write_png(const std::string &path, const std::vector<unsigned char> &rgb, unsigned w, unsigned h) {
+    std::vector<unsigned char> raw;
+    raw.reserve((size_t)(w * 3 + 1) * h);
+    for (unsigned y = 0; y < h; ++y) {
+        raw.push_back(0); // filter: none
+        raw.insert(raw.end(), rgb.begin() + (size_t)y * w * 3, rgb.begin() + (size_t)(y + 1) * w * 3);
+    }
+
+    std::vector<unsigned char> z = {0x78, 0x01};
+    unsigned a = 1, b = 0;
+    for (size_t pos = 0; pos < raw.size();) {
+        const size_t len = std::min<size_t>(65535, raw.size() - pos);
+        z.push_back(pos + len == raw.size() ? 1 : 0);
+        z.push_back((unsigned char)len);
+        z.push_back((unsigned char)(len >> 8));
+        z.push_back((unsigned char)~len);
+        z.push_back((unsigned char)(~len >> 8));
+        for (size_t i = 0; i < len; ++i) {
+            a = (a + raw[pos + i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    }
+    put_be32(z, (b << 16) | a);
+
+    std::vector<unsigned char> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<unsigned char> ihdr;
+    put_be32(ihdr, w);
+    put_be32(ihdr, h);
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8-bit RGB
+    png_chunk(png, "IHDR", ihdr);
+    png_chunk(png, "IDAT", z);
+    png_chunk(png, "IEND", {});
+
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(png.data(), 1, png.size(), f) == png.size();
+    return (fclose(f) == 0) && ok;
+}
+
+// - Conversion ----------------------------------------------------------------
+
+static bool read_file(const fs::path &path, std::vector<unsigned char> &data) {
+    FILE *f = fopen(path.string().c_str(), "rb");
+    if (!f)
+        return false;
+    data.clear();
+    unsigned char buf[16384];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static std::string lower_ext(const fs::path &path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)tolower(c); });
+    return ext;
+}
+
+static bool is_supported(const fs::path &path) {
+    const std::string ext = lower_ext(path);
+    return ext == ".scr" || ext == ".img" || ext == ".mg1" || ext == ".mg2" || ext == ".mg4" || ext == ".mg8";
+}
+
+// Next to the input, or under -o with the input's file name
+static fs::path output_path(const fs::path &path) {
+    fs::path out = s_opt.out_dir.empty() ? path : fs::path(s_opt.out_dir) / path.filename();
+    out += s_opt.png ? ".png" : ".ppm";
+    return out;
+}
+
+static bool convert_file(const fs::path &path, std::string &err) {
+    std::vector<unsigned char> data;
+    if (!read_file(path, data)) {
+        err = "cannot read";
+        return false;
+    }
+
+    zx_image_t img;
+    if (!parse_image(data, lower_ext(path), img, err))
+        return false;
+
+    std::vector<unsigned short> px;
+    render_image(img, px);
+
+    std::vector<unsigned char> rgb;
+    to_rgb888(px, s_opt.scale, rgb);
+
+    const fs::path out = output_path(path);
+
+    const unsigned w = SCREEN_W * s_opt.scale, h = SCREEN_H * s_opt.scale;
+    if (!(s_opt.png ? write_png(out.string(), rgb, w, h) : write_ppm(out.string(), rgb, w, h))) {
+        err = "cannot write " + out.string();
+        return false;
+    }
+    return true;
+}
+
+// - Work-stealing pool --------------------------------------------------------
+
+typedef struct {
+    std::mutex lock;
+    std::deque<size_t> tasks;
+} worker_queue_t;
+
+static std::vector<fs::path> s_files;
+static std::vector<worker_queue_t> s_queues;
+static std::atomic<unsigned> s_done{0};
+static std::atomic<unsigned> s_failed{0};
+static std::mutex s_log_lock;
+
+// Own queue is used LIFO (back), victims are robbed FIFO (front)
+static bool next_task(unsigned self, size_t &task) {
+    {
+        worker_queue_t &q = s_queues[self];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            task = q.tasks.back();
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < s_queues.size(); ++i) {
+        worker_queue_t &victim = s_queues[(self + i) % s_queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+static void worker_main(unsigned self) {
+    size_t task;
+    while (next_task(self, task)) {
+        std::string err;
+        const bool ok = convert_file(s_files[task], err);
+        ++s_done;
+        if (!ok)
+            ++s_failed;
+        if (!ok || !s_opt.quiet) {
+            std::lock_guard<std::mutex> guard(s_log_lock);
+            if (ok)
+                printf("%s\n", s_files[task].string().c_str());
+            else
+                fprintf(stderr, "%s: %s\n", s_files[task].string().c_str(), err.c_str());
+        }
+    }
+}
+
+// - Main ----------------------------------------------------------------------
+
+static void usage(void) {
+    fprintf(stderr, "Usage: gigascreen_convert [-o dir] [-f ppm|png] [-g gamma] [-r ratio] [-s 1|2] [-j threads] [-q]"
+                    " <file|dir>...\n");
+}
+
+// Every input must get its own output file: under -o, files with the same name
+// from different directories (or an input listed twice) would overwrite each
+// other. Reports all collisions.
+static bool check_outputs(void) {
+    std::map<std::string, size_t> seen;
+    bool ok = true;
+    for (size_t i = 0; i < s_files.size(); ++i) {
+        const std::string out = output_path(s_files[i]).lexically_normal().string();
+        std::string key = out;
+#ifdef _WIN32
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)tolower(c); });
+#endif
+        const auto it = seen.emplace(key, i).first;
+        if (it->second != i) {
+            fprintf(stderr, "%s and %s would both be written to %s\n", s_files[it->second].string().c_str(),
+                    s_files[i].string().c_str(), out.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void collect(const fs::path &path) {
+    std::error_code ec;
+    if (fs::is_directory(path, ec)) {
+        for (fs::recursive_directory_iterator it(path, ec), end; it != end; it.increment(ec)) {
+            if (ec)
+                break;
+            if (it->is_regular_file(ec) && is_supported(it->path()))
+                s_files.push_back(it->path());
+        }
+    } else {
+        s_files.push_back(path);
+    }
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (a[0] == '-' && a[1] && !a[2] && strchr("ofgrsj", a[1])) {
+            if (++i >= argc) {
+                usage();
+                return 2;
+            }
+            const char *v = argv[i];
+            switch (a[1]) {
+            case 'o': s_opt.out_dir = v; break;
+            case 'f':
+                if (strcmp(v, "png") && strcmp(v, "ppm")) {
+                    fprintf(stderr, "Unknown output format: %s\n", v);
+                    usage();
+                    return 2;
+                }
+                s_opt.png = strcmp(v, "png") == 0;
+                break;
+            case 'g': s_opt.gamma = (float)atof(v); break;
+            case 'r': s_opt.ratio = (float)atof(v); break;
+            case 's': s_opt.scale = atoi(v) == 2 ? 2 : 1; break;
+            case 'j': s_opt.threads = (unsigned)atoi(v); break;
+            }
+        } else if (strcmp(a, "-q") == 0) {
+            s_opt.quiet = true;
+        } else if (a[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            collect(a);
+        }
+    }
+
+    if (s_files.empty()) {
+        usage();
+        return 2;
+    }
+    if (!check_outputs())
+        return 2;
+    if (!s_opt.out_dir.empty()) {
+        std::error_code ec;
+        fs::create_directories(s_opt.out_dir, ec);
+    }
+
+    // LUTs are built once and shared read-only by all workers
+    s_blend.lut = lutmgr_get(s_opt.gamma, s_opt.ratio);
+    s_blend.ratio = s_opt.ratio;
+    s_blend.fullbright = 0;
+
+    unsigned threads = s_opt.threads ? s_opt.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)s_files.size()));
+
+    s_queues = std::vector<worker_queue_t>(threads);
+    for (size_t i = 0; i < s_files.size(); ++i)
+        s_queues[i % threads].tasks.push_back(i);
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker_main, t);
+    worker_main(0);
+    for (std::thread &t : pool)
+        t.join();
+
+    if (!s_opt.quiet)
+        fprintf(stderr, "%u file(s) converted, %u failed\n", s_done.load() - s_failed.load(), s_failed.load());
+    return s_failed ? 1 : 0;
+}
@@ -0,0 +1,393 @@
+//------------------------------------------------------------------------------
+// Gigascreen kernel speed/accuracy evaluation
+//
+// Runs every blend kernel over the same pixel sequences and compares the
+// result with a double-precision reference of the same blend: components are
+// decoded with the plugin's sRGB/gamma curve, averaged in linear light with
+// the kernel's frame weights and encoded back, without any quantization.
+//
+// Reported per kernel, in one table:
+// - max error per channel, in 8-bit steps
+// - mean and max CIE76 colour difference (dE), via sRGB -> CIELAB (D65)
+// - PSNR over all channels
+// - throughput in megapixels per second
+//
+// The error includes the unavoidable RGB565 output quantization, so a kernel
+// that exactly matches the reference up to rounding still shows a small dE.
+// New kernels (faster LUT layouts, reduced precision, SIMD ...) are added to
+// s_kernels[] below; with -b the fastest kernel within the dE budget is
+// named for every frame count.
+//
+// Inputs:
+// - synthetic (default): every combination of the 15 ZX Spectrum colours
+//   plus random RGB565 sequences
+// - replay (-i): raw RGB565 little-endian frames of -s WxH; every pixel of
+//   every frame forms a sequence with the same pixel of the preceding frames
+//
+// Build: see build_tools.cmd (Windows) or build_tools.sh (Linux).
+//
+// Usage:
+//   gigascreen_eval [options]
+//     -g <gamma>     gamma (default: 2.2)
+//     -r <ratio>     ratio (default: 0.5)
+//     -n <count>     random sequences added to the synthetic set (default: 1000000)
+//     -i <file>      replay raw RGB565 frames instead of the synthetic set
+//     -s <WxH>       frame size for -i (default: 352x296)
+//     -b <dE>        accuracy budget (mean dE) for picking the fastest kernel
+//------------------------------------------------------------------------------
+
+#include "../src/blend_core.h"
+#include "../src/lut_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_FRAMES 4
+
+// ZX Spectrum palette (normal / bright), 8-bit per component
+#define ZX_NORMAL 0xD7
+#define ZX_BRIGHT 0xFF
+
+// minimum time spent timing each kernel
+#define MIN_BENCH_SECONDS 0.2
+
+typedef struct {
+    float gamma = 2.2f;
+    float ratio = 0.5f;
+    unsigned random = 1000000;
+    const char *replay = NULL;
+    unsigned w = 352;
+    unsigned h = 296;
+    double budget = -1.0;
+} options_t;
+
+static options_t s_opt;
+static blend_params_t s_blend;
+
+// Pixel sequences, one plane per frame (plane 0 = most recent frame)
+static std::vector<unsigned short> s_planes[MAX_FRAMES];
+
+// - Kernels -------------------------------------------------------------------
+
+typedef void (*kernel_fn)(const unsigned short *const *planes, unsigned short *out, size_t n);
+
+static void kernel_gigascreen(const unsigned short *const *p, unsigned short *out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = (unsigned short)gigascreen_blend(s_blend, p[0][i], p[1][i]);
+}
+
+static void kernel_tricolor(const unsigned short *const *p, unsigned short *out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = (unsigned short)tricolor_blend(s_blend, p[0][i], p[1][i], p[2][i]);
+}
+
+static void kernel_quadcolor(const unsigned short *const *p, unsigned short *out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = (unsigned short)quadcolor_blend(s_blend, p[0][i], p[1][i], p[2][i], p[3][i]);
+}
+
+// Baseline: weighted average of the encoded values, no gamma handling at all
+static void kernel_gigascreen_encoded(const unsigned short *const *p, unsigned short *out, size_t n) {
+    const unsigned w0 = (unsigned)(s_blend.ratio * 256.0f + 0.5f), w1 = 256 - w0;
+    for (size_t i = 0; i < n; ++i) {
+        unsigned a = p[0][i], b = p[1][i];
+        unsigned r = (((a >> 11) & 0x1F) * w0 + ((b >> 11) & 0x1F) * w1 + 128) >> 8;
+        unsigned g = (((a >> 5) & 0x3F) * w0 + ((b >> 5) & 0x3F) * w1 + 128) >> 8;
+        unsigned bl = ((a & 0x1F) * w0 + (b & 0x1F) * w1 + 128) >> 8;
+        out[i] = (unsigned short)((r << 11) | (g << 5) | bl);
+    }
+}
+
+typedef struct {
+    const char *name;
+    unsigned frames; // frames blended, selects the reference weights
+    kernel_fn fn;
+} kernel_t;
+
+static const kernel_t s_kernels[] = {
+    {"gigascreen_lut2d", 2, kernel_gigascreen},
+    {"gigascreen_encoded", 2, kernel_gigascreen_encoded},
+    {"tricolor_lut", 3, kernel_tricolor},
+    {"quadcolor_lut", 4, kernel_quadcolor},
+};
+
+#define KERNEL_COUNT (sizeof(s_kernels) / sizeof(s_kernels[0]))
+
+// - Reference -----------------------------------------------------------------
+
+// The plugin's transfer curve (lut_manager.cpp), in double precision
+static double ref_to_linear(double c, double gamma) {
+    return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, gamma);
+}
+
+static double ref_to_encoded(double c, double gamma) {
+    return c <= 0.0031308 ? 12.92 * c : 1.055 * pow(c, 1.0 / gamma) - 0.055;
+}
+
+static void rgb565_to_unit(unsigned px, double rgb[3]) {
+    rgb[0] = ((px >> 11) & 0x1F) / 31.0;
+    rgb[1] = ((px >> 5) & 0x3F) / 63.0;
+    rgb[2] = (px & 0x1F) / 31.0;
+}
+
+// Blend of n frames as the plugin defines it: the mean of all frames mixed
+// with the most recent one, (1 - ratio) * 2 being the weight of the mean.
+// For n = 2 this is p0 * ratio + p1 * (1 - ratio).
+static void reference_blend(const unsigned short *px, unsigned n, double gamma, double ratio, double out[3]) {
+    const double w_mean = (1.0 - ratio) * 2.0;
+    double lin[MAX_FRAMES][3];
+    for (unsigned f = 0; f < n; ++f) {
+        double c[3];
+        rgb565_to_unit(px[f], c);
+        for (int k = 0; k < 3; ++k)
+            lin[f][k] = ref_to_linear(c[k], gamma);
+    }
+    for (int k = 0; k < 3; ++k) {
+        double mean = 0.0;
+        for (unsigned f = 0; f < n; ++f)
+            mean += lin[f][k];
+        mean /= n;
+        double v = mean * w_mean + lin[0][k] * (1.0 - w_mean);
+        out[k] = std::min(1.0, std::max(0.0, ref_to_encoded(v, gamma)));
+    }
+}
+
+// Display colour (standard sRGB) -> CIELAB, D65 white
+static void unit_to_lab(const double rgb[3], double lab[3]) {
+    double lin[3];
+    for (int k = 0; k < 3; ++k)
+        lin[k] = ref_to_linear(rgb[k], 2.4);
+
+    double x = (0.4124564 * lin[0] + 0.3575761 * lin[1] + 0.1804375 * lin[2]) / 0.95047;
+    double y = 0.2126729 * lin[0] + 0.7151522 * lin[1] + 0.0721750 * lin[2];
+    double z = (0.0193339 * lin[0] + 0.1191920 * lin[1] + 0.9503041 * lin[2]) / 1.08883;
+
+    const double e = 216.0 / 24389.0, kappa = 24389.0 / 27.0;
+    double f[3] = {x, y, z};
+    for (int k = 0; k < 3; ++k)
+        f[k] = f[k] > e ? cbrt(f[k]) : (kappa * f[k] + 16.0) / 116.0;
+
+    lab[0] = 116.0 * f[1] - 16.0;
+    lab[1] = 500.0 * (f[0] - f[1]);
+    lab[2] = 200.0 * (f[1] - f[2]);
+}
+
+// - Inputs --------------------------------------------------------------------
+
+static unsigned short zx_color565(unsigned index, bool bright) {
+    const unsigned level = bright ? ZX_BRIGHT : ZX_NORMAL;
+    unsigned r = (index & 2) ? level : 0;
+    unsigned g = (index & 4) ? level : 0;
+    unsigned b = (index & 1) ? level : 0;
+    return (unsigned short)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static void add_sequence(const unsigned short *px) {
+    for (int f = 0; f < MAX_FRAMES; ++f)
+        s_planes[f].push_back(px[f]);
+}
+
+static void synth_sequences(void) {
+    // 15 distinct colours: black plus 7 normal and 7 bright
+    unsigned short palette[15];
+    palette[0] = 0;
+    for (unsigned i = 1; i < 8; ++i) {
+        palette[i] = zx_color565(i, false);
+        palette[i + 7] = zx_color565(i, true);
+    }
+
+    unsigned short px[MAX_FRAMES];
+    for (unsigned a = 0; a < 15; ++a)
+        for (unsigned b = 0; b < 15; ++b)
+            for (unsigned c = 0; c < 15; ++c)
+                for (unsigned d = 0; d < 15; ++d) {
+                    px[0] = palette[a];
+                    px[1] = palette[b];
+                    px[2] = palette[c];
+                    px[3] = palette[d];
+                    add_sequence(px);
+                }
+
+    // fixed seed, so runs are comparable
+    unsigned long long state = 0x9E3779B97F4A7C15ull;
+    for (unsigned i = 0; i < s_opt.random; ++i) {
+        for (int f = 0; f < MAX_FRAMES; ++f) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            px[f] = (unsigned short)(state >> 48);
+        }
+        add_sequence(px);
+    }
+}
+
+static bool load_replay(void) {
+    FILE *f = fopen(s_opt.replay, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", s_opt.replay);
+        return false;
+    }
+    const size_t pixels = (size_t)s_opt.w * s_opt.h;
+    std::vector<unsigned char> buf(pixels * 2);
+    std::vector<std::vector<unsigned short> > frames;
+    while (fread(&buf[0], 1, buf.size(), f) == buf.size()) {
+        frames.push_back(std::vector<unsigned short>(pixels));
+        for (size_t i = 0; i < pixels; ++i)
+            frames.back()[i] = (unsigned short)(buf[i * 2] | (buf[i * 2 + 1] << 8));
+    }
+    fclose(f);
+
+    if (frames.size() < MAX_FRAMES) {
+        fprintf(stderr, "%s: need at least %d complete %ux%u RGB565 frames\n", s_opt.replay, MAX_FRAMES, s_opt.w,
+                s_opt.h);
+        return false;
+    }
+    unsigned short px[MAX_FRAMES];
+    for (size_t n = MAX_FRAMES - 1; n < frames.size(); ++n) {
+        for (size_t i = 0; i < pixels; ++i) {
+            for (int k = 0; k < MAX_FRAMES; ++k)
+                px[k] = frames[n - k][i];
+            add_sequence(px);
+        }
+    }
+    return true;
+}
+
+// - Evaluation ----------------------------------------------------------------
+
+typedef struct {
+    double max_err[3]; // 8-bit steps
+    double mean_de;
+    double max_de;
+    double psnr;
+    double mpx_per_s;
+} result_t;
+
+static void evaluate(const kernel_t &k, result_t &res) {
+    const size_t n = s_planes[0].size();
+    const unsigned short *planes[MAX_FRAMES];
+    for (int f = 0; f < MAX_FRAMES; ++f)
+        planes[f] = &s_planes[f][0];
+    std::vector<unsigned short> out(n);
+
+    // throughput: repeat until the measurement is long enough
+    k.fn(planes, &out[0], n); // warm-up
+    unsigned runs = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    double seconds = 0.0;
+    do {
+        k.fn(planes, &out[0], n);
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (seconds < MIN_BENCH_SECONDS);
+    res.mpx_per_s = (double)n * runs / seconds / 1e6;
+
+    // accuracy
+    memset(res.max_err, 0, sizeof(res.max_err));
+    double sq_sum = 0.0, de_sum = 0.0;
+    res.max_de = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        unsigned short px[MAX_FRAMES];
+        for (int f = 0; f < MAX_FRAMES; ++f)
+            px[f] = planes[f][i];
+
+        double ref[3], got[3], ref_lab[3], got_lab[3];
+        reference_blend(px, k.frames, s_opt.gamma, s_opt.ratio, ref);
+        rgb565_to_unit(out[i], got);
+
+        for (int c = 0; c < 3; ++c) {
+            double d = got[c] - ref[c];
+            res.max_err[c] = std::max(res.max_err[c], fabs(d) * 255.0);
+            sq_sum += d * d;
+        }
+
+        unit_to_lab(ref, ref_lab);
+        unit_to_lab(got, got_lab);
+        double de = sqrt((ref_lab[0] - got_lab[0]) * (ref_lab[0] - got_lab[0]) +
+                         (ref_lab[1] - got_lab[1]) * (ref_lab[1] - got_lab[1]) +
+                         (ref_lab[2] - got_lab[2]) * (ref_lab[2] - got_lab[2]));
+        de_sum += de;
+        res.max_de = std::max(res.max_de, de);
+    }
+    const double mse = sq_sum / (3.0 * n);
+    res.mean_de = de_sum / n;
+    res.psnr = mse > 0.0 ? 10.0 * log10(1.0 / mse) : INFINITY;
+}
+
+// - Main ----------------------------------------------------------------------
+
+static void usage(void) {
+    fprintf(stderr, "Usage: gigascreen_eval [-g gamma] [-r ratio] [-n count] [-i file] [-s WxH] [-b dE]\n");
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (a[0] == '-' && a[1] && !a[2] && strchr("grnisb", a[1])) {
+            if (++i >= argc) {
+                usage();
+                return 2;
+            }
+            const char *v = argv[i];
+            switch (a[1]) {
+            case 'g': s_opt.gamma = (float)atof(v); break;
+            case 'r': s_opt.ratio = (float)atof(v); break;
+            case 'n': s_opt.random = (unsigned)atoi(v); break;
+            case 'i': s_opt.replay = v; break;
+            case 'b': s_opt.budget = atof(v); break;
+            case 's':
+                if (sscanf(v, "%ux%u", &s_opt.w, &s_opt.h) != 2 || !s_opt.w || !s_opt.h) {
+                    usage();
+                    return 2;
+                }
+                break;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // same clamping as the LUT builder, so the reference matches the kernels
+    s_opt.gamma = std::max(1.0f, s_opt.gamma);
+    s_opt.ratio = std::min(1.0f, std::max(0.5f, s_opt.ratio));
+
+    if (!s_opt.replay)
+        synth_sequences();
+    else if (!load_replay())
+        return 1;
+
+    s_blend.lut = lutmgr_get(s_opt.gamma, s_opt.ratio);
+    s_blend.ratio = s_opt.ratio;
+    s_blend.fullbright = 0;
+
+    printf("gamma %.2f, ratio %.2f, %zu sequences (%s)\n", s_opt.gamma, s_opt.ratio, s_planes[0].size(),
+           s_opt.replay ? s_opt.replay : "synthetic");
+    printf("%-20s %6s %6s %6s %6s %8s %8s %8s %9s\n", "kernel", "frames", "maxR", "maxG", "maxB", "mean dE",
+           "max dE", "PSNR dB", "Mpx/s");
+
+    result_t results[KERNEL_COUNT];
+    for (size_t k = 0; k < KERNEL_COUNT; ++k) {
+        result_t &r = results[k];
+        evaluate(s_kernels[k], r);
+        printf("%-20s %6u %6.2f %6.2f %6.2f %8.3f %8.3f %8.2f %9.1f\n", s_kernels[k].name, s_kernels[k].frames,
+               r.max_err[0], r.max_err[1], r.max_err[2], r.mean_de, r.max_de, r.psnr, r.mpx_per_s);
+    }
+
+    if (s_opt.budget >= 0.0) {
+        printf("\nfastest kernel within mean dE %.3f:\n", s_opt.budget);
+        for (unsigned frames = 2; frames <= MAX_FRAMES; ++frames) {
+            int best = -1;
+            for (size_t k = 0; k < KERNEL_COUNT; ++k) {
+                if (s_kernels[k].frames != frames || results[k].mean_de > s_opt.budget)
+                    continue;
+                if (best < 0 || results[k].mpx_per_s > results[best].mpx_per_s)
+                    best = (int)k;
+            }
+            printf("  %u frames: %s\n", frames, best >= 0 ? s_kernels[best].name : "none");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+// Gigascreen default LUT generator
+//
+// Writes src/lut_defaults.h: the LUT set for the default gamma/ratio as a
+// compile-time table, so the plugin's common configuration needs no runtime
+// table builds. The tables come from lutmgr_build(), i.e. the same code that
+// builds every other set, so they stay bit-identical.
+//
+// Re-run after changing the LUT builder in lut_manager.cpp:
+//   gigascreen_lutgen > src/lut_defaults.h
+// and check that the compiled-in table is current with:
+//   gigascreen_lutgen -c
+//
+// Build: see build_tools.cmd (Windows) or build_tools.sh (Linux).
+//------------------------------------------------------------------------------
+
+#include "../src/lut_manager.h"
+#include <cstdio>
+#include <cstring>
+
+// Keep in sync with DEFAULT_GAMMA / DEFAULT_RATIO in blend_engine.h
+#define GEN_GAMMA 2.2f
+#define GEN_RATIO 0.5f
+
+static void print_row(const unsigned char *v, int n, const char *indent) {
+    printf("%s{", indent);
+    for (int i = 0; i < n; ++i)
+        printf(i ? ", %u" : "%u", v[i]);
+    printf("}");
+}
+
+static void print_table(const char *name, const unsigned char *v, int rows, int cols) {
+    printf("    // %s\n", name);
+    if (rows == 1) {
+        print_row(v, cols, "    ");
+        printf(",\n");
+        return;
+    }
+    printf("    {\n");
+    for (int r = 0; r < rows; ++r) {
+        print_row(v + r * cols, cols, "        ");
+        printf(",\n");
+    }
+    printf("    },\n");
+}
+
+int main(int argc, char **argv) {
+    lut_set_t set;
+    lutmgr_build(&set, GEN_GAMMA, GEN_RATIO);
+
+    if (argc > 1 && strcmp(argv[1], "-c") == 0) {
+        const lut_set_t *compiled = lutmgr_get(GEN_GAMMA, GEN_RATIO);
+        if (memcmp(compiled, &set, sizeof(set)) != 0) {
+            fprintf(stderr, "src/lut_defaults.h is out of date, regenerate it\n");
+            return 1;
+        }
+        fprintf(stderr, "src/lut_defaults.h is up to date\n");
+        return 0;
+    }
+    if (argc > 1) {
+        fprintf(stderr, "Usage: gigascreen_lutgen [-c] > src/lut_defaults.h\n");
+        return 2;
+    }
+
+    printf("//------------------------------------------------------------------------------\n");
+    printf("// Default LUT set (gamma %.1f, ratio %.1f) as a compile-time table\n", GEN_GAMMA, GEN_RATIO);
+    printf("//\n");
+    printf("// Generated by tools/gigascreen_lutgen.cpp - do not edit.\n");
+    printf("//------------------------------------------------------------------------------\n");
+    printf("#pragma once\n\n");
+    printf("#include \"lut_manager.h\"\n\n");
+    printf("#define LUT_DEFAULT_GAMMA %.1ff\n", GEN_GAMMA);
+    printf("#define LUT_DEFAULT_RATIO %.1ff\n\n", GEN_RATIO);
+    printf("// clang-format off\n");
+    printf("static constexpr lut_set_t lut_default_set = {\n");
+    print_table("blend_5b", &set.blend_5b[0][0], 32, 32);
+    print_table("blend_6b", &set.blend_6b[0][0], 64, 64);
+    print_table("fwd_5b", set.fwd_5b, 1, 32);
+    print_table("fwd_6b", set.fwd_6b, 1, 64);
+    print_table("rev_5b", set.rev_5b, 1, 32);
+    print_table("rev_6b", set.rev_6b, 1, 64);
+    printf("};\n");
+    printf("// clang-format on\n");
+    return 0;
+}
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+// Gigascreen live statistics reader
+//
+// Attaches to the stats block a running plugin publishes with stats=1 in
+// gigascreen.cfg (see src/stats_manager.h) and prints it at a fixed interval:
+// frame rate, active settings, dropped frames, per-stage time histograms over
+// the last frames and the share of pixels per blending path. Reading never
+// disturbs the emulator: the plugin does not wait for readers, a torn copy is
+// detected through the sequence counter and simply taken again.
+//
+// Build: see build_tools.cmd (Windows) or build_tools.sh (Linux).
+//
+// Usage:
+//   gigascreen_stats [options]
+//     -i <ms>        refresh interval (default: 1000)
+//     -n <count>     number of reports, 0 = until interrupted (default: 0)
+//------------------------------------------------------------------------------
+
+#include "../src/stats_manager.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// Copy attempts before a snapshot is given up (the writer holds the block for
+// well under a microsecond per frame)
+#define SNAPSHOT_RETRIES 1000
+
+#define BAR_WIDTH 40
+
+static const char *s_stage_names[STATS_STAGES] = {"blend", "present", "capture", "overlay"};
+static const char *s_class_names[STATS_CLASSES] = {"pass",    "static", "Gigascreen", "scroll",
+                                                   "3Color",  "4-phase", "motion",    "phosphor"};
+static const char *s_view_names[] = {"off", "overlay", "map"};
+
+static struct {
+    unsigned interval_ms = 1000;
+    unsigned count = 0;
+} s_opt;
+
+// - Mapping -------------------------------------------------------------------
+
+static const stats_block_t *open_block(void) {
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, STATS_MAPPING_NAME);
+    if (!mapping)
+        return NULL;
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(stats_block_t));
+    CloseHandle(mapping); // the view keeps the mapping alive
+    return (const stats_block_t *)view;
+#else
+    int fd = shm_open(STATS_MAPPING_NAME, O_RDONLY, 0);
+    if (fd < 0)
+        return NULL;
+    void *view = mmap(NULL, sizeof(stats_block_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return view == MAP_FAILED ? NULL : (const stats_block_t *)view;
+#endif
+}
+
+static void sleep_ms(unsigned ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// Seqlock read: copy until the sequence is even and unchanged around the copy.
+// The acquire fence keeps the copy ahead of the second sequence load.
+static bool snapshot(const stats_block_t *block, stats_block_t *out) {
+    for (int i = 0; i < SNAPSHOT_RETRIES; ++i) {
+        const uint32_t seq = block->seq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            sleep_ms(0);
+            continue;
+        }
+        memcpy((void *)out, (const void *)block, sizeof(*out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block->seq.load(std::memory_order_relaxed) == seq)
+            return true;
+    }
+    return false;
+}
+
+// - Report --------------------------------------------------------------------
+
+static void print_bar(double fraction) {
+    int n = (int)(fraction * BAR_WIDTH + 0.5);
+    n = n < 0 ? 0 : n > BAR_WIDTH ? BAR_WIDTH : n;
+    putchar('|');
+    for (int i = 0; i < BAR_WIDTH; ++i)
+        putchar(i < n ? '#' : ' ');
+    putchar('|');
+}
+
+// Upper bound (us) of the bin holding the given quantile of a histogram
+static unsigned hist_quantile(const uint32_t *hist, unsigned total, double q) {
+    const unsigned target = (unsigned)(total * q + 0.5);
+    unsigned seen = 0;
+    for (unsigned b = 0; b < STATS_HIST_BINS; ++b) {
+        seen += hist[b];
+        if (seen >= target && seen)
+            return 2u << b;
+    }
+    return 2u << (STATS_HIST_BINS - 1);
+}
+
+static void print_stage(int s, const stats_block_t &b) {
+    unsigned total = 0, peak = 0, first = STATS_HIST_BINS, last = 0;
+    for (unsigned i = 0; i < STATS_HIST_BINS; ++i) {
+        const unsigned n = b.stage_hist[s][i];
+        total += n;
+        if (n > peak)
+            peak = n;
+        if (n && first == STATS_HIST_BINS)
+            first = i;
+        if (n)
+            last = i;
+    }
+    if (!total) {
+        printf("  %-8s not run\n", s_stage_names[s]);
+        return;
+    }
+    printf("  %-8s last %6u us, p50 < %u us, p99 < %u us (%u frames)\n", s_stage_names[s], b.stage_last_us[s],
+           hist_quantile(b.stage_hist[s], total, 0.5), hist_quantile(b.stage_hist[s], total, 0.99), total);
+    for (unsigned i = first; i <= last; ++i) {
+        printf("    %6u-%-6u us ", i ? 1u << i : 0u, 2u << i);
+        print_bar((double)b.stage_hist[s][i] / peak);
+        printf(" %u\n", b.stage_hist[s][i]);
+    }
+}
+
+static void report(const stats_block_t &b, const stats_block_t *prev, unsigned elapsed_ms) {
+    if (b.pid)
+        printf("pid %u, ", b.pid);
+    else
+        printf("plugin closed, ");
+    printf("%ux%u, frame %llu", b.width, b.height, (unsigned long long)b.frames);
+    if (prev && prev->pid == b.pid && b.frames >= prev->frames && elapsed_ms)
+        printf(", %.1f fps", (b.frames - prev->frames) * 1000.0 / elapsed_ms);
+    if (b.passthrough)
+        printf(", %llu passthrough", (unsigned long long)b.passthrough);
+    printf("\n");
+
+    const int view = b.debug_view >= 0 && b.debug_view < 3 ? b.debug_view : 0;
+    printf("mode %d, gamma %.2f, ratio %.2f, motion_check %d, pipeline %d, debug view %s\n", b.mode, b.gamma,
+           b.ratio, b.motion_check, b.pipeline, s_view_names[view]);
+    printf("capture %s, %llu frames dropped\n", b.capturing ? "on" : "off", (unsigned long long)b.capture_dropped);
+
+    printf("stage times over the last %u frames:\n", STATS_WINDOW);
+    for (int s = 0; s < STATS_STAGES; ++s)
+        print_stage(s, b);
+
+    unsigned long long pixels = 0;
+    for (int c = 0; c < STATS_CLASSES; ++c)
+        pixels += b.class_pixels[c];
+    if (pixels) {
+        printf("pixels per path (last frame):\n");
+        for (int c = 0; c < STATS_CLASSES; ++c) {
+            const double share = (double)b.class_pixels[c] / pixels;
+            printf("  %-10s %6.2f%% ", s_class_names[c], share * 100.0);
+            print_bar(share);
+            printf("\n");
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+// - Main ----------------------------------------------------------------------
+
+static void usage(void) {
+    fprintf(stderr, "Usage: gigascreen_stats [-i ms] [-n count]\n");
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (a[0] == '-' && a[1] && !a[2] && strchr("in", a[1])) {
+            if (++i >= argc) {
+                usage();
+                return 2;
+            }
+            const char *v = argv[i];
+            switch (a[1]) {
+            case 'i': s_opt.interval_ms = (unsigned)atoi(v); break;
+            case 'n': s_opt.count = (unsigned)atoi(v); break;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (!s_opt.interval_ms)
+        s_opt.interval_ms = 1;
+
+    const stats_block_t *block = open_block();
+    if (!block) {
+        fprintf(stderr, "No stats published (is the plugin running with stats=1?)\n");
+        return 1;
+    }
+
+    stats_block_t cur, prev;
+    bool have_prev = false;
+    for (unsigned n = 0; !s_opt.count || n < s_opt.count; ++n) {
+        if (n)
+            sleep_ms(s_opt.interval_ms);
+        if (!snapshot(block, &cur)) {
+            fprintf(stderr, "Stats block busy, skipped\n");
+            continue;
+        }
+        if (cur.magic != STATS_MAGIC || cur.version != STATS_VERSION || cur.size != sizeof(stats_block_t)) {
+            fprintf(stderr, "Stats block version %u does not match this reader (%u)\n", cur.version, STATS_VERSION);
+            return 1;
+        }
+        report(cur, have_prev ? &prev : NULL, s_opt.interval_ms);
+        memcpy((void *)&prev, (const void *)&cur, sizeof(prev));
+        have_prev = true;
+    }
+    return 0;
+}